@@ -1,14 +1,29 @@
+#include <cstdio>
+#include <memory>
+#include <f1tm/replay.hpp>
 #include <f1tm/sim_runner.hpp>
 #include <f1tm/viewer/app.hpp>
 
 using namespace f1tm;
 
-int main() {
+int main(int argc, char** argv) {
   SimRunner sim;
   sim.configure_default_world();
+
+  // Optional: play back a recorded race (.f1rec) instead of the live sim.
+  ReplayLog log;
+  std::unique_ptr<ReplaySource> replay;
+  if (argc > 1) {
+    if (!log.open(argv[1])) {
+      std::fprintf(stderr, "cannot open replay: %s\n", argv[1]);
+      return 1;
+    }
+    if (log.track_id() > 0) sim.request_track_preset(static_cast<TrackPreset>(log.track_id() - 1));
+    replay = std::make_unique<ReplaySource>(log);
+  }
   sim.start();
 
-  ViewerApp app(sim);
+  ViewerApp app(sim, replay.get());
   const int code = app.run();
 
   sim.stop();
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <f1tm/sim.hpp>       // CarId
+#include <f1tm/snap.hpp>      // CarPose
+#include <f1tm/track_mesh.hpp> // MeshColor, MeshVertex
+
+namespace f1tm {
+
+// Stable CarId -> palette color, assigned in first-seen order (wrapping the palette).
+// Dense table indexed by id: one load per lookup, no hashing. Ids at or above
+// kDenseIds take palette[id % size] without an entry.
+class CarColorTable {
+public:
+  static constexpr CarId kDenseIds = 1u << 16;
+
+  MeshColor color(CarId id);
+  static std::span<const MeshColor> palette();
+
+private:
+  static constexpr std::uint8_t kUnassigned = 0xFF;
+  std::vector<std::uint8_t> slot_;  // palette index per id
+  std::uint32_t assigned_{0};
+};
+
+// One frame of car glyphs (heading triangle plus a centre marker) as a triangle list
+// in screen pixels, same layout and winding as TrackMesh. The vertex buffer keeps its
+// capacity, so steady-state frames do not allocate.
+class CarBatch {
+public:
+  static constexpr std::size_t kMarkerSides = 8;
+  static constexpr std::size_t kVertsPerCar = 3 + 3 * kMarkerSides;
+
+  // Screen position is (ox + x*scale, oy - y*scale), as ViewerApp::worldToScreen_.
+  // With a screen view box, cars whose glyph lies entirely outside it are skipped.
+  void build(std::span<const CarPose> cars, float scale_px_per_m, float ox, float oy,
+             CarColorTable& colors, const Box2* view = nullptr);
+
+  const std::vector<MeshVertex>& vertices() const { return verts_; }
+  std::size_t car_count() const { return verts_.size() / kVertsPerCar; }
+
+private:
+  std::vector<MeshVertex> verts_;
+};
+
+} // namespace f1tm
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+
+namespace f1tm {
+
+// Stateless counter-based generator: each value is a pure function of
+// (key, stream, counter), so any scenario can be drawn on any thread in any order and
+// the results do not depend on how work is split. The mixer is the SplitMix64 finalizer
+// applied twice over Weyl-spaced inputs.
+class CounterRng {
+public:
+  explicit constexpr CounterRng(std::uint64_t seed = 0) : key_(mix(seed ^ kGolden)) {}
+
+  constexpr std::uint64_t bits(std::uint64_t stream, std::uint64_t counter) const {
+    return mix(mix(key_ + stream * kGolden) ^ (counter * kWeyl + kWeyl));
+  }
+
+  // Uniform in [0, 1) with 53 random bits.
+  constexpr double uniform(std::uint64_t stream, std::uint64_t counter) const {
+    return double(bits(stream, counter) >> 11) * 0x1.0p-53;
+  }
+
+  // Independent child generator (e.g., one per candidate or per decision).
+  constexpr CounterRng split(std::uint64_t child) const {
+    CounterRng r{};
+    r.key_ = mix(key_ ^ mix(child + kWeyl));
+    return r;
+  }
+
+private:
+  static constexpr std::uint64_t kGolden = 0x9E3779B97F4A7C15ull;
+  static constexpr std::uint64_t kWeyl   = 0xD1B54A32D192ED03ull;
+
+  static constexpr std::uint64_t mix(std::uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+
+  std::uint64_t key_;
+};
+
+} // namespace f1tm
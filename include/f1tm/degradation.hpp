@@ -0,0 +1,140 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <vector>
+
+namespace f1tm {
+
+// Tyre degradation policies. Lap i of a stint (0-based) costs base + lap_delta(i);
+// cumulative(n) is sum_{i<n} lap_delta(i) in O(1) (closed form). Stint kernels are
+// templated on the policy, so each model gets its own specialized loop.
+template <class D>
+concept DegradationModel = requires(const D& d, int n) {
+  { d.lap_delta(n) } -> std::convertible_to<double>;
+  { d.cumulative(n) } -> std::convertible_to<double>;
+  { d.valid() } -> std::convertible_to<bool>;
+};
+
+namespace deg_detail {
+// sum_{i<n} i and sum_{i<n} i^2
+inline double s1(double n) { return n * (n - 1.0) * 0.5; }
+inline double s2(double n) { return (n - 1.0) * n * (2.0 * n - 1.0) / 6.0; }
+} // namespace deg_detail
+
+// delta(i) = per_lap * i (the StintParams model).
+struct LinearDeg {
+  double per_lap = 0.0;
+  bool valid() const { return per_lap >= 0.0; }
+  double lap_delta(int i) const { return per_lap * double(i); }
+  double cumulative(int n) const {
+    const double m = double(n);
+    return per_lap * m * (m - 1.0) * 0.5;
+  }
+};
+
+// delta(i) = linear * i + quadratic * i^2.
+struct QuadraticDeg {
+  double linear = 0.0;
+  double quadratic = 0.0;
+  bool valid() const { return linear >= 0.0 && quadratic >= 0.0; }
+  double lap_delta(int i) const { return linear * double(i) + quadratic * double(i) * double(i); }
+  double cumulative(int n) const {
+    return linear * deg_detail::s1(double(n)) + quadratic * deg_detail::s2(double(n));
+  }
+};
+
+// Warm-up, linear phase and cliff:
+//   warm-up: warmup_s extra on lap 0, fading linearly to 0 by lap warmup_laps;
+//   linear:  per_lap * i;
+//   cliff:   from lap cliff_lap on, an extra cliff_per_lap * (i - cliff_lap + 1).
+struct CliffDeg {
+  double per_lap = 0.0;
+  double warmup_s = 0.0;
+  int warmup_laps = 0;
+  int cliff_lap = 0;          // <= 0: no cliff
+  double cliff_per_lap = 0.0;
+  bool valid() const {
+    return per_lap >= 0.0 && warmup_s >= 0.0 && warmup_laps >= 0 && cliff_per_lap >= 0.0;
+  }
+  double lap_delta(int i) const {
+    double d = per_lap * double(i);
+    if (i < warmup_laps) d += warmup_s * double(warmup_laps - i) / double(warmup_laps);
+    if (cliff_lap > 0 && i >= cliff_lap) d += cliff_per_lap * double(i - cliff_lap + 1);
+    return d;
+  }
+  double cumulative(int n) const {
+    double d = per_lap * deg_detail::s1(double(n));
+    if (warmup_laps > 0) {
+      const double k = double(std::min(n, warmup_laps)), w = double(warmup_laps);
+      d += warmup_s / w * (k * w - deg_detail::s1(k));
+    }
+    if (cliff_lap > 0 && n > cliff_lap) {
+      const double m = double(n - cliff_lap);
+      d += cliff_per_lap * m * (m + 1.0) * 0.5;
+    }
+    return d;
+  }
+};
+
+// delta(i) = scale * (exp(rate * i) - 1): slow start, accelerating wear.
+struct ExponentialDeg {
+  double scale = 0.0;
+  double rate = 0.0;
+  bool valid() const { return scale >= 0.0 && rate >= 0.0; }
+  double lap_delta(int i) const { return scale * std::expm1(rate * double(i)); }
+  double cumulative(int n) const {
+    if (rate == 0.0 || n <= 0) return 0.0;
+    // sum_{i<n} e^{ri} = (e^{rn} - 1) / (e^r - 1)
+    return scale * (std::expm1(rate * double(n)) / std::expm1(rate) - double(n));
+  }
+};
+
+// Any policy tabulated as prefix sums up to max_laps; O(1) per lookup afterwards.
+// Laps past the table are extended with the source model's lap_delta.
+template <DegradationModel D>
+class DegradationTable {
+public:
+  DegradationTable(const D& model, int max_laps) : model_(model) {
+    prefix_.resize(std::size_t(std::max(0, max_laps)) + 1, 0.0);
+    for (std::size_t i = 1; i < prefix_.size(); ++i) {
+      prefix_[i] = prefix_[i - 1] + model.lap_delta(int(i - 1));
+    }
+  }
+  bool valid() const { return model_.valid(); }
+  double lap_delta(int i) const { return model_.lap_delta(i); }
+  double cumulative(int n) const {
+    if (n <= 0) return 0.0;
+    if (std::size_t(n) < prefix_.size()) return prefix_[std::size_t(n)];
+    double d = prefix_.back();
+    for (int i = int(prefix_.size()) - 1; i < n; ++i) d += model_.lap_delta(i);
+    return d;
+  }
+
+private:
+  D model_;
+  std::vector<double> prefix_;
+};
+
+// A stint under degradation policy D (StintParams is the LinearDeg case).
+template <DegradationModel D>
+struct ModelStint {
+  int laps = 0;
+  double baseLap = 0.0;
+  D deg{};
+};
+
+// estimate_stint_time for any policy, with the same guards (0 for no laps, base <= 0 or
+// an invalid model). For LinearDeg the arithmetic matches estimate_stint_time exactly.
+template <DegradationModel D>
+double stint_time(int laps, double base, const D& deg) {
+  if (laps <= 0 || base <= 0.0 || !deg.valid()) return 0.0;
+  return double(laps) * base + deg.cumulative(laps);
+}
+
+template <DegradationModel D>
+double estimate_stint_time(const ModelStint<D>& s) {
+  return stint_time(s.laps, s.baseLap, s.deg);
+}
+
+} // namespace f1tm
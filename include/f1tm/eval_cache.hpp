@@ -0,0 +1,113 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include <f1tm/event_stream.hpp>
+#include <f1tm/stint.hpp>
+#include <f1tm/track.hpp>
+
+namespace f1tm {
+
+// Canonical form of a strategy evaluation input: stint fields and track numbers
+// quantized to 1e-9, the track key bytes, the packed event words and caller-defined
+// context words (e.g., Monte Carlo options, so one strategy scored two ways gets two
+// keys), flattened into 64-bit words with a 64-bit hash. Inputs that quantize equally
+// share one key.
+class StrategyKey {
+public:
+  static constexpr double kScale = 1e9;
+
+  StrategyKey() = default;
+  StrategyKey(const std::vector<StintParams>& stints, const Track& track,
+              const PackedEventStream& events, std::span<const std::uint64_t> context = {}) {
+    assign(stints, track, events, context);
+  }
+
+  // Rebuilds in place, reusing storage.
+  void assign(const std::vector<StintParams>& stints, const Track& track,
+              const PackedEventStream& events, std::span<const std::uint64_t> context = {});
+
+  // Context word for a double option, quantized like the stint fields.
+  static std::uint64_t quantized(double v);
+
+  std::uint64_t hash() const { return hash_; }
+  std::span<const std::uint64_t> words() const { return words_; }
+  bool operator==(const StrategyKey& o) const { return hash_ == o.hash_ && words_ == o.words_; }
+
+private:
+  std::vector<std::uint64_t> words_;
+  std::uint64_t hash_{0};
+};
+
+struct EvalCacheConfig {
+  std::size_t capacity = 1u << 14;  // entries, split evenly across shards
+  std::size_t shards = 8;           // rounded up to a power of two
+};
+
+// Bounded memo keyed by StrategyKey. Each shard is an LRU list plus a hash index
+// behind its own mutex, so concurrent callers mostly take different locks. A hit costs
+// one key build (a StrategyKey allocates its words unless assign() reuses one) and one
+// lookup; an insert into a full shard recycles its least recently used entry.
+// Only worth it for evaluators that cost well above a hit (~0.1-0.2 us), such as
+// Monte Carlo scoring (rank_strategies_under_risk); closed-form race_time_with_track
+// is cheaper to recompute.
+// Thread-safe; stats() may be read from any thread.
+class EvaluationCache {
+public:
+  struct Stats {
+    std::atomic<std::uint64_t> hits{0};
+    std::atomic<std::uint64_t> misses{0};
+    std::atomic<std::uint64_t> evictions{0};
+  };
+
+  explicit EvaluationCache(EvalCacheConfig cfg = {});
+  EvaluationCache(const EvaluationCache&) = delete;
+  EvaluationCache& operator=(const EvaluationCache&) = delete;
+
+  // Counts a hit or a miss; a hit becomes most recently used.
+  std::optional<double> find(const StrategyKey& key);
+  void insert(const StrategyKey& key, double value);
+
+  // eval() -> std::optional<double> runs on a miss, outside any lock (concurrent misses
+  // on one key may both evaluate). nullopt results are not cached.
+  template <class F>
+  std::optional<double> get_or_compute(const StrategyKey& key, F&& eval) {
+    if (const auto v = find(key)) return v;
+    const std::optional<double> v = eval();
+    if (v) insert(key, *v);
+    return v;
+  }
+
+  std::size_t size() const;
+  std::size_t capacity() const { return per_shard_ * shards_.size(); }
+  void clear();  // drops entries; counters are kept
+
+  const Stats& stats() const { return stats_; }
+  double hit_rate() const;
+
+private:
+  struct Entry {
+    StrategyKey key;
+    double value{0.0};
+  };
+  struct Shard {
+    mutable std::mutex mu;
+    std::list<Entry> lru;  // most recent first
+    std::unordered_map<std::uint64_t, std::list<Entry>::iterator> index; // by key hash
+  };
+
+  Shard& shard_(const StrategyKey& key) { return *shards_[key.hash() & (shards_.size() - 1)]; }
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::size_t per_shard_{1};
+  Stats stats_;
+};
+
+} // namespace f1tm
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+#include <f1tm/track.hpp>
+
+namespace f1tm {
+
+// Race condition at a pit window. Values are the 2-bit codes used by PackedEventStream.
+enum class RaceEvent : std::uint8_t { Green = 0, VSC = 1, SC = 2 };
+
+// "SC", "VSC", "GREEN"
+std::string_view to_string(RaceEvent e);
+// Case-insensitive; "" is Green. nullopt for anything else.
+std::optional<RaceEvent> parse_race_event(std::string_view s);
+
+// Per-window event probabilities, clamped to [0, 1] and renormalized (keeping the
+// SC:VSC ratio) when they sum past 1. draw() maps one uniform: SC, then VSC, then Green.
+struct EventMix {
+  double sc = 0.0;
+  double vsc = 0.0;
+
+  static EventMix from(double p_sc, double p_vsc);
+  RaceEvent draw(double u) const {
+    return u < sc ? RaceEvent::SC : (u < sc + vsc ? RaceEvent::VSC : RaceEvent::Green);
+  }
+};
+
+// Events packed 2 bits each, 32 per 64-bit word (event i in bits 2*(i%32) of word i/32).
+class PackedEventStream {
+public:
+  static constexpr std::size_t kPerWord = 32;
+
+  std::size_t size() const { return n_; }
+  bool empty() const { return n_ == 0; }
+  void clear() { words_.clear(); n_ = 0; }
+  void reserve(std::size_t n) { words_.reserve((n + kPerWord - 1) / kPerWord); }
+  // New events are Green.
+  void resize(std::size_t n);
+
+  void push_back(RaceEvent e) {
+    if (n_ % kPerWord == 0) words_.push_back(0);
+    words_.back() |= std::uint64_t(e) << shift_(n_);
+    ++n_;
+  }
+  RaceEvent operator[](std::size_t i) const {
+    return RaceEvent((words_[i / kPerWord] >> shift_(i)) & 3u);
+  }
+  void set(std::size_t i, RaceEvent e) {
+    std::uint64_t& w = words_[i / kPerWord];
+    w = (w & ~(std::uint64_t{3} << shift_(i))) | (std::uint64_t(e) << shift_(i));
+  }
+
+  // Number of events of kind e (popcount over whole words).
+  std::size_t count(RaceEvent e) const;
+
+  std::span<const std::uint64_t> words() const { return words_; }
+
+private:
+  static unsigned shift_(std::size_t i) { return unsigned(2 * (i % kPerWord)); }
+
+  std::vector<std::uint64_t> words_; // bits past size() are zero
+  std::size_t n_{0};
+};
+
+// Lane factor for each event, written to out[0, s.size()); false if out is too small.
+// Decodes one word at a time through a 4-entry table (no strings, no NaN sentinel).
+bool lane_factors_from_stream(const Track& track, const PackedEventStream& s, std::span<double> out);
+std::vector<double> lane_factors_from_stream(const Track& track, const PackedEventStream& s);
+
+} // namespace f1tm
@@ -1,11 +1,29 @@
 #pragma once
+#include <cstdint>
 #include <random>
 #include <string>
 #include <vector>
+#include <f1tm/counter_rng.hpp>
+#include <f1tm/event_stream.hpp>
 #include <f1tm/track.hpp>
 
 namespace f1tm {
 
+// Typed generation: one event per pit window, drawn with EventMix::from(p_sc, p_vsc).
+// Deterministic with caller-provided rng (one uniform per event).
+PackedEventStream simulate_pit_event_stream(std::size_t count,
+                                            double p_sc,
+                                            double p_vsc,
+                                            std::mt19937& rng);
+
+// Counter-based variant: event i is drawn from rng.uniform(stream, i).
+PackedEventStream simulate_pit_event_stream(std::size_t count,
+                                            double p_sc,
+                                            double p_vsc,
+                                            const CounterRng& rng,
+                                            std::uint64_t stream);
+
+// String adapter over simulate_pit_event_stream (same draws).
 // Emit one event per pit window: "SC", "VSC", or "GREEN".
 // Probabilities: p_sc >= 0, p_vsc >= 0. We clamp and ensure total <= 1.
 // Deterministic with caller-provided rng.
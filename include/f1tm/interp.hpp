@@ -91,6 +91,7 @@ public:
         cp.x  = lerp(ca.x, cb.x, t);
         cp.y  = lerp(ca.y, cb.y, t);
         cp.s  = lerp(ca.s, cb.s, t);
+        cp.speed_mps = lerp(ca.speed_mps, cb.speed_mps, t);
         cp.heading_rad = lerp_angle_shortest(ca.heading_rad, cb.heading_rad, t);
         cp.lap = (t < 1.0 ? ca.lap : cb.lap);
 
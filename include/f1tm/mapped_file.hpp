@@ -0,0 +1,30 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace f1tm {
+
+// Read-only memory mapping of a whole file. No platform headers leak from here.
+class MappedFile {
+public:
+  MappedFile() = default;
+  ~MappedFile() { close(); }
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  bool open(const std::string& path);
+  void close();
+  const std::uint8_t* data() const { return data_; }
+  std::size_t size() const { return size_; }
+
+private:
+  const std::uint8_t* data_{nullptr};
+  std::size_t size_{0};
+#if defined(_WIN32)
+  void* file_{nullptr};
+  void* mapping_{nullptr};
+#endif
+};
+
+} // namespace f1tm
@@ -0,0 +1,144 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include <f1tm/degradation.hpp>
+#include <f1tm/eval_cache.hpp>
+#include <f1tm/sampling.hpp>
+#include <f1tm/stint.hpp>
+#include <f1tm/track.hpp>
+
+namespace f1tm {
+
+// Event-independent part of a strategy: summed stint time and number of stops.
+struct StrategyCandidate {
+  double stint_time = 0.0;
+  std::size_t stops = 0;
+};
+
+// From a non-empty list of stints of any kind with an estimate_stint_time overload
+// (StintParams, ModelStint<D>), so Monte Carlo works with any degradation policy.
+template <class Stint>
+StrategyCandidate strategy_candidate(const std::vector<Stint>& stints) {
+  StrategyCandidate c;
+  for (const auto& s : stints) c.stint_time += estimate_stint_time(s);
+  c.stops = stints.empty() ? 0 : stints.size() - 1;
+  return c;
+}
+
+// nullopt if any candidate has no stints.
+template <class Stint>
+std::optional<std::vector<StrategyCandidate>> strategy_candidates(const std::vector<std::vector<Stint>>& plans) {
+  std::vector<StrategyCandidate> out;
+  out.reserve(plans.size());
+  for (const auto& p : plans) {
+    if (p.empty()) return std::nullopt;
+    out.push_back(strategy_candidate(p));
+  }
+  return out;
+}
+
+struct MonteCarloOptions {
+  std::uint64_t scenarios = 100000;
+  std::uint64_t seed = 0;
+  double p_sc = 0.0;       // per pit window, as in simulate_pit_events
+  double p_vsc = 0.0;
+  unsigned threads = 0;    // 0 = std::thread::hardware_concurrency()
+  SamplingMode sampling = SamplingMode::Uniform;
+  std::vector<double> quantiles{0.05, 0.5, 0.95}; // each in [0, 1]
+};
+
+struct StrategyOutcome {
+  double mean = 0.0;
+  double stddev = 0.0;     // population
+  double min = 0.0;
+  double max = 0.0;
+  std::vector<double> quantiles; // nearest-rank, same order as MonteCarloOptions::quantiles
+  double win_prob = 0.0;   // fastest in a scenario (ties go to the lower index)
+};
+
+struct MonteCarloResult {
+  std::uint64_t scenarios = 0;
+  std::vector<StrategyOutcome> outcomes; // per candidate
+  std::vector<double> beats;             // [i * n + j] = P(candidate i strictly faster than j)
+
+  double p_beats(std::size_t i, std::size_t j) const { return beats[i * outcomes.size() + j]; }
+};
+
+// Race-time distribution of each candidate (stints; one stop between consecutive stints,
+// with the Track's pit loss) over sampled SC/VSC/GREEN events at each stop.
+// All candidates see the same scenarios (common random numbers). With Uniform sampling,
+// the events of scenario s are simulate_pit_event_stream(stops, p_sc, p_vsc,
+// CounterRng(seed), s); other modes draw from ScenarioSampler(sampling, CounterRng(seed)).
+// Scenarios are split across threads in fixed-size chunks and every reduction runs in
+// scenario or chunk order, so results are bit-identical for any thread count.
+// Returns nullopt for empty or malformed input.
+std::optional<MonteCarloResult> simulate_strategy_outcomes(
+    const std::vector<std::vector<StintParams>>& candidates,
+    const Track& track,
+    const MonteCarloOptions& opt = {});
+
+// Same, from precomputed candidates (e.g., strategy_candidates() over ModelStint plans).
+std::optional<MonteCarloResult> simulate_candidate_outcomes(
+    const std::vector<StrategyCandidate>& candidates,
+    const Track& track,
+    const MonteCarloOptions& opt = {});
+
+struct RiskRankOptions {
+  MonteCarloOptions mc;   // scenarios, seed, SC/VSC odds, sampling; mc.quantiles is ignored
+  double quantile = 0.9;  // score: this race-time quantile, in [0, 1]
+};
+
+struct RankedStrategy {
+  std::size_t index = 0;  // into the plans passed in
+  double score = 0.0;     // seconds
+};
+
+// Ranks plans (e.g., strategy_stints of optimize_pit_strategy's top K) by a race-time
+// quantile over sampled SC/VSC events, best first; ties keep input order. A score only
+// depends on the plan, the track and the options (common random numbers), so with a
+// cache each plan is simulated once per track and options: hits cost a key build and a
+// lookup, and all misses are scored together in one simulate_candidate_outcomes call.
+// Returns nullopt for empty plans or bad options.
+std::optional<std::vector<RankedStrategy>> rank_strategies_under_risk(
+    const std::vector<std::vector<StintParams>>& plans,
+    const Track& track,
+    const RiskRankOptions& opt = {},
+    EvaluationCache* cache = nullptr);
+
+struct PairedComparisonOptions {
+  std::uint64_t seed = 0;
+  double p_sc = 0.0;
+  double p_vsc = 0.0;
+  SamplingMode sampling = SamplingMode::Sobol;
+  double ci_half_width = 0.05;          // stop once the 95% CI on the delta is this tight (s)
+  std::uint64_t min_scenarios = 1024;
+  std::uint64_t max_scenarios = 1u << 22;
+};
+
+struct PairedComparison {
+  double mean_delta = 0.0;     // E[T_a - T_b]; negative means a is faster
+  double ci_half_width = 0.0;  // 95%
+  double p_a_faster = 0.0;     // fraction of scenarios with T_a < T_b
+  std::uint64_t scenarios = 0;
+  bool converged = false;      // false if max_scenarios was reached first
+};
+
+// Paired comparison: both strategies see identical scenarios, so only the difference
+// of their event-dependent pit losses is sampled. The sample count doubles each round
+// until the 95% confidence interval on the mean delta is within ci_half_width.
+// Uniform/Antithetic use the iid (or pair-averaged) sample variance. Sobol uses 16
+// digitally shifted replicates and a Student-t interval on their means.
+// Deterministic for a given seed. Returns nullopt for empty strategies or bad options.
+std::optional<PairedComparison> compare_strategies(const std::vector<StintParams>& a,
+                                                   const std::vector<StintParams>& b,
+                                                   const Track& track,
+                                                   const PairedComparisonOptions& opt = {});
+
+std::optional<PairedComparison> compare_candidates(const StrategyCandidate& a,
+                                                  const StrategyCandidate& b,
+                                                  const Track& track,
+                                                  const PairedComparisonOptions& opt = {});
+
+} // namespace f1tm
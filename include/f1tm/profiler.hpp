@@ -0,0 +1,106 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+namespace f1tm {
+
+// Lock-free latency histogram in nanoseconds: 8 linear sub-buckets per power of two
+// (values within 1/8 of each other share a bucket; quantiles are good to about 6%).
+// record() is a few relaxed atomic adds, so any number of threads may record while
+// others read; readers see a slightly stale but consistent-enough view.
+class StageHistogram {
+public:
+  static constexpr int kSubBits = 3;
+  static constexpr int kMaxMsb = 40;  // ~18 min; longer samples land in the last bucket
+  static constexpr std::size_t kBuckets = std::size_t(kMaxMsb - kSubBits + 2) << kSubBits;
+
+  void record(std::uint64_t ns);
+  void reset();
+
+  std::uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+  std::uint64_t total_ns() const { return sum_ns_.load(std::memory_order_relaxed); }
+  std::uint64_t max_ns() const { return max_ns_.load(std::memory_order_relaxed); }
+  double mean_ns() const;
+  // q in [0, 1]; 0 when empty. Bucket midpoint, capped at max_ns().
+  double quantile_ns(double q) const;
+
+  static std::size_t bucket_of(std::uint64_t ns);
+  static std::uint64_t bucket_lower(std::size_t bucket);
+  static std::uint64_t bucket_width(std::size_t bucket);
+
+private:
+  std::array<std::atomic<std::uint64_t>, kBuckets> buckets_{};
+  std::atomic<std::uint64_t> count_{0};
+  std::atomic<std::uint64_t> sum_ns_{0};
+  std::atomic<std::uint64_t> max_ns_{0};
+};
+
+// Named stages, each with its own histogram. Owners index stages with their own enum
+// (SimRunner::Stage, ViewerApp's stages); names are for overlays and logs.
+class StageProfiler {
+public:
+  explicit StageProfiler(std::initializer_list<const char*> names);
+
+  std::size_t size() const { return names_.size(); }
+  const char* name(std::size_t stage) const { return names_[stage]; }
+  StageHistogram& stage(std::size_t i) { return hist_[i]; }
+  const StageHistogram& stage(std::size_t i) const { return hist_[i]; }
+
+  void record(std::size_t stage, std::uint64_t ns) { hist_[stage].record(ns); }
+  void reset();
+
+private:
+  std::vector<const char*> names_;
+  std::unique_ptr<StageHistogram[]> hist_;
+};
+
+// Records the lifetime of the scope into one stage.
+class ScopedStageTimer {
+public:
+  using clock = std::chrono::steady_clock;
+
+  ScopedStageTimer(StageProfiler& p, std::size_t stage) : p_(p), stage_(stage), t0_(clock::now()) {}
+  ~ScopedStageTimer() {
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - t0_).count();
+    p_.record(stage_, ns > 0 ? std::uint64_t(ns) : 0);
+  }
+  ScopedStageTimer(const ScopedStageTimer&) = delete;
+  ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+private:
+  StageProfiler& p_;
+  std::size_t stage_;
+  clock::time_point t0_;
+};
+
+// Back-to-back stages without nesting scopes: lap() records the time since the last
+// lap (or construction) into a stage, total() the time since construction.
+class StageStopwatch {
+public:
+  using clock = std::chrono::steady_clock;
+
+  explicit StageStopwatch(StageProfiler& p) : p_(p), t0_(clock::now()), lap_(t0_) {}
+  void lap(std::size_t stage) {
+    const auto now = clock::now();
+    p_.record(stage, ns_(now - lap_));
+    lap_ = now;
+  }
+  void total(std::size_t stage) { p_.record(stage, ns_(clock::now() - t0_)); }
+
+private:
+  static std::uint64_t ns_(clock::duration d) {
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+    return ns > 0 ? std::uint64_t(ns) : 0;
+  }
+
+  StageProfiler& p_;
+  clock::time_point t0_, lap_;
+};
+
+} // namespace f1tm
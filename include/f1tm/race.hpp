@@ -5,6 +5,7 @@
 #include <vector>
 #include <f1tm/stint.hpp>
 #include <f1tm/pit.hpp>
+#include <f1tm/event_stream.hpp>
 #include <f1tm/track.hpp>
 
 namespace f1tm {
@@ -18,11 +19,17 @@ std::optional<double> race_time_with_pits_under(const std::vector<StintParams>&
                                                 const std::vector<double>& lane_factors);
 
 // NEW: Map event strings to lane factors using Track.
-// Supported events (case-insensitive): "SC", "VSC", "GREEN" (or "")
-// Returns a vector of factors same length as events.
+// Supported events (case-insensitive): "SC", "VSC", "GREEN" (or ""); see parse_race_event.
+// Returns a vector of factors same length as events; NaN for unknown events.
+// String adapter: prefer PackedEventStream + lane_factors_from_stream in hot paths.
 std::vector<double> lane_factors_from_events(const Track& track,
                                              const std::vector<std::string>& events);
 
+// Typed variant: no parsing and no unknown events; nullopt only on size mismatch.
+std::optional<double> race_time_with_track(const std::vector<StintParams>& stints,
+                                           const Track& track,
+                                           const PackedEventStream& events);
+
 // NEW: Convenience — compose stints + pits derived from Track + events.
 // Returns nullopt if sizes mismatch or an event is unknown.
 std::optional<double> race_time_with_track(const std::vector<StintParams>& stints,
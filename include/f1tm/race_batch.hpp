@@ -0,0 +1,106 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <vector>
+#include <f1tm/degradation.hpp>
+#include <f1tm/stint.hpp>
+#include <f1tm/pit.hpp>
+
+namespace f1tm {
+
+// Many candidate strategies with a common stint count, stored column-wise (SoA):
+// one contiguous column per stint field and per stop field, indexed by strategy.
+// Strategies with fewer stints are padded with zero-lap stints and zero-loss stops,
+// which add exactly 0.0 to the total. Columns can be filled directly for sweeps.
+class StrategyBatch {
+public:
+  explicit StrategyBatch(std::size_t stints = 1);
+
+  std::size_t size() const { return n_; }
+  std::size_t stints() const { return stint_cols_.size(); }
+  std::size_t stops() const { return stop_cols_.size(); }
+
+  void clear() { resize(0); }
+  void reserve(std::size_t n);
+  // Grows or shrinks every column; new strategies are all-zero (total 0.0).
+  void resize(std::size_t n);
+
+  // Append one strategy with the same validation as race_time_with_pits_under:
+  // stints non-empty, pits.size() + 1 == stints.size() == lane_factors.size() + 1,
+  // and at most stints() stints. Returns false (and appends nothing) otherwise.
+  bool add(const std::vector<StintParams>& stints,
+           const std::vector<PitParams>& pits,
+           const std::vector<double>& lane_factors);
+
+  // Column access: stint k in [0, stints()), stop k in [0, stops()).
+  std::span<int>    laps(std::size_t k)       { return stint_cols_[k].laps; }
+  std::span<double> base_lap(std::size_t k)   { return stint_cols_[k].base; }
+  std::span<double> deg_per_lap(std::size_t k){ return stint_cols_[k].deg; }
+  std::span<double> stationary(std::size_t k) { return stop_cols_[k].stationary; }
+  std::span<double> lane(std::size_t k)       { return stop_cols_[k].lane; }
+  std::span<double> lane_factor(std::size_t k){ return stop_cols_[k].factor; }
+
+  std::span<const int>    laps(std::size_t k) const        { return stint_cols_[k].laps; }
+  std::span<const double> base_lap(std::size_t k) const    { return stint_cols_[k].base; }
+  std::span<const double> deg_per_lap(std::size_t k) const { return stint_cols_[k].deg; }
+  std::span<const double> stationary(std::size_t k) const  { return stop_cols_[k].stationary; }
+  std::span<const double> lane(std::size_t k) const        { return stop_cols_[k].lane; }
+  std::span<const double> lane_factor(std::size_t k) const { return stop_cols_[k].factor; }
+
+private:
+  struct StintCols { std::vector<int> laps; std::vector<double> base, deg; };
+  struct StopCols  { std::vector<double> stationary, lane, factor; };
+
+  std::size_t n_{0};
+  std::vector<StintCols> stint_cols_;
+  std::vector<StopCols>  stop_cols_;
+};
+
+// Race time of every strategy in the batch, written to out[0, batch.size()).
+// Same clamps and summation order as race_time_with_pits_under, so results agree with
+// the scalar path to the last bit unless the compiler contracts to FMA differently.
+// Branch-free inner loops over the columns so the compiler can vectorize them.
+// Returns false if out is too small.
+bool race_time_batch(const StrategyBatch& batch, std::span<double> out);
+
+// Same, for strategies [first, first + out.size()) only (for chunked/parallel callers).
+bool race_time_batch(const StrategyBatch& batch, std::size_t first, std::span<double> out);
+
+namespace batch_detail {
+// Strategies per tile. The accumulator is a local array, so the compiler can prove it
+// does not alias the input columns and vectorizes the column loops without runtime checks.
+inline constexpr std::size_t kTile = 256;
+// pit_stop_loss_under over a column slice, accumulated into acc.
+void add_stop_column(const double* stat, const double* lane, const double* factor,
+                     double* acc, std::size_t n);
+} // namespace batch_detail
+
+// Race time under degradation policy D: models[k * batch.size() + i] is the model of
+// stint k of strategy i (column-major like the batch); the deg_per_lap columns are not
+// used. The stint loop is instantiated per policy. Returns false on size mismatch.
+template <DegradationModel D>
+bool race_time_batch(const StrategyBatch& batch, std::span<const D> models, std::span<double> out) {
+  using batch_detail::kTile;
+  const std::size_t N = batch.size();
+  if (out.size() < N || models.size() != batch.stints() * N) return false;
+  double acc[kTile];
+  for (std::size_t t0 = 0; t0 < N; t0 += kTile) {
+    const std::size_t n = std::min(kTile, N - t0);
+    std::fill(acc, acc + n, 0.0);
+    for (std::size_t k = 0; k < batch.stints(); ++k) {
+      const int* laps = batch.laps(k).data() + t0;
+      const double* base = batch.base_lap(k).data() + t0;
+      const D* m = models.data() + k * N + t0;
+      for (std::size_t i = 0; i < n; ++i) acc[i] += stint_time(laps[i], base[i], m[i]);
+      if (k < batch.stops()) {
+        batch_detail::add_stop_column(batch.stationary(k).data() + t0, batch.lane(k).data() + t0,
+                                      batch.lane_factor(k).data() + t0, acc, n);
+      }
+    }
+    std::copy(acc, acc + n, out.data() + t0);
+  }
+  return true;
+}
+
+} // namespace f1tm
@@ -0,0 +1,60 @@
+#pragma once
+#include <optional>
+#include <vector>
+#include <f1tm/pit.hpp>
+#include <f1tm/stint.hpp>
+
+namespace f1tm {
+
+// estimate_stint_time extended to real lap counts: n*base + deg*n*(n-1)/2 (0 if invalid).
+double stint_time_continuous(double laps, double base, double deg);
+
+// Partial derivatives of race time (race_time_with_pits_under model).
+struct StintGradient {
+  double d_laps = 0.0;  // base + deg*(laps - 1/2): marginal cost of stretching the stint
+  double d_base = 0.0;  // laps
+  double d_deg  = 0.0;  // laps*(laps - 1)/2
+};
+struct StopGradient {
+  double d_stationary = 0.0;  // 1 (0 where the clamp at 0 is active)
+  double d_lane = 0.0;        // clamped lane factor (0 where lane is clamped)
+  double d_lane_factor = 0.0; // lane (0 outside (0, 1), where the factor is clamped)
+};
+struct RaceTimeGradient {
+  double total = 0.0;
+  std::vector<StintGradient> stints;
+  std::vector<StopGradient> stops;
+};
+
+// Exact, closed form. Inputs validated like race_time_with_pits_under (nullopt on mismatch).
+// Stints that estimate_stint_time treats as invalid (base <= 0, deg < 0) have zero gradient.
+std::optional<RaceTimeGradient> race_time_gradient(const std::vector<StintParams>& stints,
+                                                   const std::vector<PitParams>& pits,
+                                                   const std::vector<double>& lane_factors);
+
+struct LapSplitOptions {
+  int min_stint_laps = 1;
+  std::vector<int> max_stint_laps; // per stint (0 = unlimited); empty = unlimited
+};
+
+struct LapSplitResult {
+  std::vector<int> laps;               // integer optimum, sums to race_laps
+  std::vector<double> continuous_laps; // relaxed optimum
+  double total_time = 0.0;             // race_time_with_pits_under with `laps`
+  int newton_steps = 0;                // active-set Newton solves for the relaxation
+  int evaluations = 0;                 // stint-time evaluations in the integer phase
+};
+
+// Best split of race_laps over the given stints (their laps fields are ignored; compounds,
+// stops and lane factors stay fixed). Each stint cost is a convex quadratic in its laps,
+// so the relaxation is solved by Newton steps on the KKT system with an active set for the
+// lap bounds. The integer phase rounds down, adds the missing laps by smallest marginal
+// cost, then applies single-lap transfers until none improves, which is optimal for
+// separable convex costs. nullopt if inputs are invalid or the bounds are infeasible.
+std::optional<LapSplitResult> optimize_lap_split(int race_laps,
+                                                 const std::vector<StintParams>& stints,
+                                                 const std::vector<PitParams>& pits,
+                                                 const std::vector<double>& lane_factors,
+                                                 const LapSplitOptions& opt = {});
+
+} // namespace f1tm
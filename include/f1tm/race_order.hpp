@@ -0,0 +1,68 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <f1tm/snap.hpp>
+
+namespace f1tm {
+
+// Whole milliseconds shown for a time in seconds; -1 if unknown (negative or not finite).
+std::int64_t race_time_ms(double s);
+// "m:ss.mmm" (or "s.mmm" under a minute), "--" when unknown. Returns chars written.
+int format_race_time(double s, char* out, int cap);
+// "+s.mmm", "--" when unknown. Returns chars written.
+int format_race_gap(double s, char* out, int cap);
+
+// One dashboard row: latest pose plus its cached cell text.
+struct RaceOrderRow {
+  CarPose pose{};
+  char pos[8]{};
+  char id[16]{};
+  char lap[24]{};
+  char gap[24]{};
+  char last[24]{};
+  char best[24]{};
+  char s1[24]{};
+  char s2[24]{};
+  char s3[24]{};
+};
+
+// Client-side running order (lap desc, then s desc) for the dashboard and race control.
+// Order is kept by insertion sort over the previous frame's order, so a frame without
+// overtakes is one linear pass. Cell text is re-formatted only when its shown value
+// (whole ms, lap, position) changes. While the snapshot's car ids stay the same, in the
+// same order, update() does not allocate; any other change rebuilds the rows.
+class RaceOrder {
+public:
+  void update(std::span<const CarPose> cars);
+  void clear();
+
+  std::size_t size() const { return order_.size(); }
+  bool empty() const { return order_.empty(); }
+  const RaceOrderRow& operator[](std::size_t pos) const { return rows_[order_[pos]]; } // 0 = leader
+  const CarPose& leader() const { return rows_[order_.front()].pose; }
+
+  // Lowest last-sector time among the cars (sector 1..3); -1 if none is known.
+  double sector_min(int sector) const { return sector_min_[sector - 1]; }
+  // Poses in running order (allocates; for results files).
+  std::vector<CarPose> poses() const;
+
+  // Cells re-formatted since construction (text cache effectiveness).
+  std::uint64_t formatted_cells() const { return formatted_; }
+
+private:
+  struct Shown {  // values the cached text was formatted from
+    std::int64_t lap, gap, last, best, s1, s2, s3;
+    std::uint32_t pos;
+  };
+  void refresh_text_(std::uint32_t slot, std::uint32_t pos);
+
+  std::vector<RaceOrderRow> rows_;  // one per car, in snapshot order
+  std::vector<Shown> shown_;
+  std::vector<std::uint32_t> order_; // row slots by position
+  double sector_min_[3]{-1.0, -1.0, -1.0};
+  std::uint64_t formatted_{0};
+};
+
+} // namespace f1tm
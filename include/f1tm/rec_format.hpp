@@ -0,0 +1,74 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <f1tm/sim.hpp> // for CarId
+
+namespace f1tm {
+
+// Recorded race log (.f1rec), little-endian:
+//   RecFileHeader, then a sequence of [RecBlockHeader][payload] blocks.
+// Frame blocks hold whole ticks (a tick never spans blocks). Each payload is
+// columnar: per column a varint byte length followed by zigzag-varint deltas of
+// quantized values (time/id/tick against the previous row; everything else
+// against the same car's previous row in the block).
+
+inline constexpr char kRecMagic[8] = {'F','1','T','M','R','E','C','1'};
+inline constexpr std::uint32_t kRecVersion = 1;
+inline constexpr std::uint32_t kRecBlockMagic = 0x314B4C42; // "BLK1"
+
+enum class RecBlockKind : std::uint32_t { Frames = 1, Events = 2 };
+
+struct RecFileHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t track_id;  // 0 = unknown, else TrackPreset + 1
+};
+
+struct RecBlockHeader {
+  std::uint32_t magic;
+  std::uint32_t kind;     // RecBlockKind
+  std::uint32_t rows;
+  std::uint32_t bytes;    // payload size
+  double t_first;
+  double t_last;
+};
+static_assert(sizeof(RecFileHeader) == 16);
+static_assert(sizeof(RecBlockHeader) == 32);
+
+// Quantization steps
+inline constexpr double kRecTimeScale    = 1e6; // microseconds
+inline constexpr double kRecMeterScale   = 1e3; // millimeters (s, x, y, speed)
+inline constexpr double kRecHeadingScale = 1e5; // 10 microradians
+
+// One car at one tick.
+struct RecordRow {
+  double t{};
+  std::uint64_t tick{};
+  CarId id{};
+  std::uint32_t lap{};
+  double s{};
+  double x{};
+  double y{};
+  double heading_rad{};
+  double speed_mps{};
+};
+
+enum class RecordEventKind : std::uint32_t { LapCompleted = 1 };
+
+struct RecordEvent {
+  double t{};
+  CarId id{};
+  RecordEventKind kind{RecordEventKind::LapCompleted};
+  double value{};   // e.g. lap time (s)
+};
+
+// Block payload codecs. Decoders return false on malformed input.
+void rec_encode_frames(const RecordRow* rows, std::size_t n, std::vector<std::uint8_t>& out);
+bool rec_decode_frames(const std::uint8_t* p, std::size_t bytes, std::uint32_t rows,
+                       std::vector<RecordRow>& out);
+void rec_encode_events(const RecordEvent* ev, std::size_t n, std::vector<std::uint8_t>& out);
+bool rec_decode_events(const std::uint8_t* p, std::size_t bytes, std::uint32_t rows,
+                       std::vector<RecordEvent>& out);
+
+} // namespace f1tm
@@ -0,0 +1,99 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <f1tm/rec_format.hpp>
+#include <f1tm/sim.hpp>
+#include <f1tm/snap.hpp>
+#include <f1tm/spsc_ring.hpp>
+#include <f1tm/telemetry.hpp>
+
+namespace f1tm {
+
+struct RecorderConfig {
+  std::size_t ring_rows = std::size_t{1} << 16;  // ~13 s of 20 cars at 240 Hz
+  std::size_t ring_events = 1024;
+  std::size_t block_rows = 4096;                 // frame rows per compressed block
+};
+
+// Background race recorder. The producer (sim thread) hands rows to a lock-free
+// SPSC ring and never touches the file; a writer thread opens it, writes the header,
+// drains the ring, encodes columnar blocks (rec_format.hpp) and appends them to disk.
+// start() and stop() only hand commands to that thread: stop() returns at once and
+// the writer finishes the session (drain, flush, close) in the background.
+//
+// Threading: start/stop/join/record/record_event from one producer thread only.
+// stats() may be read from any thread.
+class Recorder {
+public:
+  struct Stats {
+    std::atomic<std::uint64_t> rows_written{0};
+    std::atomic<std::uint64_t> events_written{0};
+    std::atomic<std::uint64_t> blocks_written{0};
+    std::atomic<std::uint64_t> bytes_written{0};
+    std::atomic<std::uint64_t> frames_dropped{0}; // ring full; whole tick skipped
+    std::atomic<std::uint64_t> events_dropped{0};
+    std::atomic<std::uint64_t> open_failures{0};  // file could not be opened
+  };
+
+  explicit Recorder(RecorderConfig cfg = {});
+  ~Recorder() { stop(); join(); }
+  Recorder(const Recorder&) = delete;
+  Recorder& operator=(const Recorder&) = delete;
+
+  // Starts a session; the writer opens the file. false if already recording or the
+  // previous session is still being written (retry later). If the file cannot be
+  // opened, the writer counts an open failure and recording() turns false.
+  // track_id goes to the file header so a replay can rebuild the track (0 = unknown).
+  bool start(const std::string& path, std::uint32_t track_id = 0);
+  // Ends the session without waiting: rows recorded so far are still written.
+  void stop();
+  // Waits until the writer has flushed and closed the file. Blocks on disk I/O, so
+  // not for the tick; for shutdown and for readers that need the finished file.
+  void join();
+  bool recording() const { return running_.load(std::memory_order_relaxed); }
+  // A session's writer is still running (stopped sessions until the file is closed).
+  bool writing() const { return th_.joinable() && !writer_done_.load(std::memory_order_acquire); }
+  const std::string& path() const { return path_; }
+
+  // Producer side, never blocks. Returns false if the tick/event was dropped.
+  bool record(const SimSnapshot& snap);
+  bool record_event(const RecordEvent& ev);
+
+  const Stats& stats() const { return stats_; }
+
+private:
+  void writer_main_(std::uint32_t track_id);
+  void drain_();
+  void flush_frames_();
+  void flush_events_();
+  void write_block_(RecBlockKind kind, std::uint32_t rows, double t0, double t1);
+
+  RecorderConfig cfg_;
+  SpscRing<RecordRow> rows_;
+  SpscRing<RecordEvent> events_;
+  std::thread th_;
+  std::atomic<bool> running_{false};
+  std::atomic<bool> stop_{false};
+  std::atomic<bool> writer_done_{false};
+  std::string path_;
+  Stats stats_;
+
+  // Writer-thread state
+  std::ofstream out_;
+  std::vector<RecordRow> pending_rows_;
+  std::vector<RecordEvent> pending_events_;
+  std::vector<std::uint8_t> payload_;
+};
+
+// LapCompleted events for cars whose lap counter passed lap_seen (per car index; grows
+// as cars appear), stamped with the telemetry's interpolated lap-line time. A car's
+// first lap-line crossing is untimed, so it only advances lap_seen. Returns the number
+// of events handed to the recorder.
+std::size_t record_lap_events(Recorder& rec, const SimServer& sim, const TelemetrySink& telem,
+                              std::vector<std::uint64_t>& lap_seen, double now_time);
+
+} // namespace f1tm
@@ -0,0 +1,85 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <f1tm/mapped_file.hpp>
+#include <f1tm/rec_format.hpp>
+#include <f1tm/snap.hpp>
+
+namespace f1tm {
+
+// Memory-mapped .f1rec log with a sparse sim_time -> block index (one entry per
+// frame block, built from block headers only). Frames are decoded a block at a time
+// into a cache, so sequential playback touches the mapped bytes once per block and
+// frame_at() in the same block is a binary search plus a copy.
+// Not thread-safe (the block cache is mutable); use from one thread.
+class ReplayLog {
+public:
+  struct BlockRef {
+    std::size_t offset{0};   // payload offset in the file
+    std::uint32_t rows{0};
+    std::uint32_t bytes{0};
+    double t_first{0.0};
+    double t_last{0.0};
+  };
+
+  bool open(const std::string& path); // false if missing, not an .f1rec or corrupt
+  bool empty() const { return blocks_.empty(); }
+  double t_begin() const { return blocks_.empty() ? 0.0 : blocks_.front().t_first; }
+  double t_end() const { return blocks_.empty() ? 0.0 : blocks_.back().t_last; }
+  std::uint32_t track_id() const { return track_id_; } // 0 = unknown, else TrackPreset + 1
+  const std::vector<BlockRef>& blocks() const { return blocks_; }
+  const std::vector<RecordEvent>& events() const { return events_; }
+
+  // Latest recorded tick with time <= t (clamped to the first tick). Returns false
+  // if the log is empty or a block fails to decode.
+  bool frame_at(double t, SimSnapshot& out) const;
+  // Recorded tick number of that frame (0 if none); no snapshot copy.
+  std::uint64_t tick_at(double t) const;
+
+private:
+  bool load_block_(std::size_t b) const;
+  // Locate the frame for t: loads its block and returns the tick index in tick_start_.
+  bool locate_(double t, std::size_t& tick_idx) const;
+
+  MappedFile file_;
+  std::vector<BlockRef> blocks_;
+  std::vector<RecordEvent> events_;
+  std::uint32_t track_id_{0};
+
+  // Decoded block cache
+  mutable std::size_t cached_{static_cast<std::size_t>(-1)};
+  mutable std::vector<RecordRow> rows_;
+  mutable std::vector<std::uint32_t> tick_start_; // row index of each tick in rows_
+};
+
+// Playback clock over a ReplayLog with the SnapshotBuffer consumer interface, so a
+// viewer can read it in place of a live SimRunner. Client-thread only.
+class ReplaySource {
+public:
+  explicit ReplaySource(const ReplayLog& log) : log_(log), t_(log.t_begin()) {}
+
+  void set_paused(bool p) { paused_ = p; }
+  bool paused() const { return paused_; }
+  void set_warp(double w) { warp_ = w < 0.0 ? 0.0 : w; }
+  double warp() const { return warp_; }
+
+  void seek(double t);               // clamps to [t_begin, t_end]
+  void advance(double wall_dt);      // moves playback time by wall_dt * warp unless paused
+  double time() const { return t_; }
+  bool at_end() const { return t_ >= log_.t_end(); }
+
+  // Same contract as LatestBuffer::try_consume_latest: true if the frame at the
+  // playback time changed since `cursor`.
+  bool try_consume_latest(std::uint64_t& cursor, SimSnapshot& out);
+
+private:
+  const ReplayLog& log_;
+  double t_{0.0};
+  double warp_{1.0};
+  bool paused_{false};
+  std::uint64_t seq_{1};  // bumped on every seek so consumers always refresh
+};
+
+} // namespace f1tm
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <f1tm/counter_rng.hpp>
+
+namespace f1tm {
+
+// How scenario uniforms are generated for strategy Monte Carlo.
+enum class SamplingMode : std::uint8_t {
+  Uniform,     // independent counter-based draws
+  Antithetic,  // scenarios 2m and 2m+1 use u and 1 - u
+  Sobol,       // digitally shifted Sobol points (randomized quasi-Monte Carlo)
+};
+
+// Sobol sequence in Gray-code order, 32-bit, Joe-Kuo direction numbers for the first
+// kMaxDims dimensions. point(n, d) is a pure function of the index, so any range of
+// points can be generated on any thread.
+class SobolSequence {
+public:
+  static constexpr std::size_t kMaxDims = 8;
+  static constexpr unsigned kBits = 32;
+
+  SobolSequence();
+  std::uint32_t point_bits(std::uint64_t n, std::size_t d) const;
+  double point(std::uint64_t n, std::size_t d) const { return double(point_bits(n, d)) * 0x1.0p-32; }
+
+private:
+  std::uint32_t v_[kMaxDims][kBits];
+};
+
+// Uniform u(scenario, dim) in [0, 1] for the selected mode. Sobol dimensions past
+// SobolSequence::kMaxDims fall back to independent draws.
+class ScenarioSampler {
+public:
+  ScenarioSampler(SamplingMode mode, const CounterRng& rng);
+
+  SamplingMode mode() const { return mode_; }
+  double uniform(std::uint64_t scenario, std::size_t dim) const;
+
+private:
+  SamplingMode mode_;
+  CounterRng rng_;
+  std::uint32_t shift_[SobolSequence::kMaxDims]{};
+};
+
+} // namespace f1tm
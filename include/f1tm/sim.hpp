@@ -6,6 +6,7 @@
 #include <cmath>
 #include <optional>
 #include <f1tm/track_geom.hpp>
+#include <f1tm/speed_profile.hpp>
 
 namespace f1tm {
 
@@ -24,19 +25,30 @@ struct CarState {
   double s = 0.0;            // arc position along track [0, circumference)
   double speed_mps = 50.0;   // meters per second
   std::uint64_t laps = 0;    // completed lap count
+  double lateral_m = 0.0;    // offset from centerline (+left of travel direction)
+  double perf = 1.0;         // performance factor on the track speed profile
 };
 
 // Authoritative simulation server (supports circle or path).
 class SimServer {
 public:
   TrackCircle track;       // legacy circle
-  void set_track_path(const TrackPath& p) { path_ = p; use_path_ = true; }
-  void clear_track_path() { use_path_ = false; path_ = TrackPath{}; }
+  void set_track_path(const TrackPath& p);
+  void clear_track_path() { use_path_ = false; path_ = TrackPath{}; profile_ = SpeedProfile{}; }
   const std::optional<TrackPath>& track_path() const { return path_; }
 
+  // --- Speed profile (path tracks only)
+  // When enabled, step() drives each car at profile.speed_at(s) * perf and writes the
+  // result to speed_mps; otherwise cars keep their constant speed_mps.
+  void enable_speed_profile(const SpeedProfileParams& params = {});
+  void disable_speed_profile() { use_profile_ = false; profile_ = SpeedProfile{}; }
+  const SpeedProfile& speed_profile() const { return profile_; }
+
   // --- Car management
   void clear_cars() { cars_.clear(); }
-  void add_car(CarId id, double speed_mps, double s0 = 0.0, std::uint64_t laps0 = 0);
+  void add_car(CarId id, double speed_mps, double s0 = 0.0, std::uint64_t laps0 = 0,
+               double lateral0 = 0.0);
+  void add_car(const CarState& cs) { cars_.push_back(cs); }
   std::size_t car_count() const { return cars_.size(); }
 
   // Access by index (0..N-1). Returns nullptr if out of range.
@@ -50,7 +62,7 @@ public:
   // --- Simulation
   void step(double dt_sec);
 
-  // Sample arclength s -> world-space (x,y,heading_rad)
+  // Sample arclength s -> world-space (x,y,heading_rad); per-car samples include lateral_m
   void sample_pose(double& x, double& y, double& heading_rad) const;
   void sample_pose_index(std::size_t idx, double& x, double& y, double& heading_rad) const;
   bool sample_pose_for(CarId id, double& x, double& y, double& heading_rad) const;
@@ -62,13 +74,21 @@ private:
   std::vector<CarState> cars_;
   std::optional<TrackPath> path_{};
   bool use_path_{false};
+  SpeedProfile profile_{};
+  SpeedProfileParams profile_params_{};
+  bool use_profile_{false};
+
+  void pose_at_(double s, double lateral, double& x, double& y, double& heading_rad) const;
 
-  static void s_to_pose_circle(const TrackCircle& trk, double s, double& x, double& y, double& heading_rad) {
+  static void s_to_pose_circle(const TrackCircle& trk, double s, double lateral,
+                               double& x, double& y, double& heading_rad) {
     const double C = trk.circumference_m();
     if (C <= 0.0) { x = y = 0.0; heading_rad = 0.0; return; }
     const double t = (s / C) * (2.0 * std::numbers::pi_v<double>); // angle
-    x = trk.center_x + trk.radius_m * std::cos(t);
-    y = trk.center_y + trk.radius_m * std::sin(t);
+    // Counter-clockwise travel: left of travel is toward the center.
+    const double r = trk.radius_m - lateral;
+    x = trk.center_x + r * std::cos(t);
+    y = trk.center_y + r * std::sin(t);
     heading_rad = t + (std::numbers::pi_v<double> / 2.0); // tangent orientation
   }
 };
@@ -8,6 +8,10 @@
 #include <f1tm/snap.hpp>
 #include <f1tm/snap_buffer.hpp>
 #include <f1tm/track_geom.hpp>
+#include <f1tm/telemetry.hpp>
+#include <f1tm/profiler.hpp>
+#include <f1tm/tick_scheduler.hpp>
+#include <f1tm/recorder.hpp>
 
 namespace f1tm {
 
@@ -44,6 +48,36 @@ public:
   SnapshotBuffer& buffer() { return buffer_; }
   const SnapshotBuffer& buffer() const { return buffer_; }
 
+  // End-of-race statistics: request from the UI thread; the server thread
+  // publishes a RaceSummary built from its telemetry on the next tick.
+  void request_summary() { pending_summary_.store(true, std::memory_order_release); }
+  LatestBuffer<RaceSummary>& summary_buffer() { return summary_buffer_; }
+
+  // Telemetry timing lines: equal mini-sectors per lap (>= 1), on top of the three
+  // sectors. Applied when the server thread (re)creates its telemetry: on start,
+  // reseed and preset change.
+  void set_mini_sectors(std::size_t n) { mini_sectors_.store(n ? n : 1, std::memory_order_relaxed); }
+  std::size_t mini_sectors() const { return mini_sectors_.load(std::memory_order_relaxed); }
+
+  // Race recording (.f1rec). Requests are applied by the server thread; the recorder
+  // writes on its own thread so the tick never waits on disk.
+  void request_recording(bool on) { pending_record_.store(on ? 1 : 0, std::memory_order_release); }
+  bool recording() const { return recorder_.recording(); }
+  const Recorder::Stats& recorder_stats() const { return recorder_.stats(); }
+
+  // Per-tick stage timings, written by the server thread and readable from any thread.
+  enum Stage : std::size_t { kStageStep, kStageTelemetry, kStageSnapshot, kStagePublish, kStageTick };
+  const StageProfiler& profiler() const { return profiler_; }
+  StageProfiler& profiler() { return profiler_; }
+
+  // Tick budget: overruns, late/catch-up ticks, sleep overshoot and the achieved rate.
+  // The policy decides what a tick that starts a whole period late does; it may be
+  // changed while running (applied from the next tick).
+  const TickStats& tick_stats() const { return tick_stats_; }
+  TickStats& tick_stats() { return tick_stats_; }
+  void set_catch_up_policy(CatchUpPolicy p) { catch_up_.store(p, std::memory_order_relaxed); }
+  CatchUpPolicy catch_up_policy() const { return catch_up_.load(std::memory_order_relaxed); }
+
   // Control surface
   std::atomic<double> time_scale{1.0}; // 0.0 = paused
 
@@ -57,19 +91,30 @@ private:
 
   // Sim & data sharing
   SnapshotBuffer buffer_;
+  LatestBuffer<RaceSummary> summary_buffer_;
+  Recorder recorder_;
+  StageProfiler profiler_{"sim step", "telemetry", "snapshot build", "publish", "tick (work)"};
+  TickStats tick_stats_;
+  std::atomic<CatchUpPolicy> catch_up_{CatchUpPolicy::Burst};
 
   // World setup used by the thread
   TrackCircle track_{ .center_x = 0.0, .center_y = 0.0, .radius_m = 120.0 };
   TrackPath   path_{}; // stadium / arbitrary
   TrackPreset preset_{TrackPreset::Stadium};
-  struct CarInit { CarId id; double speed_mps; double s0; std::uint64_t laps0; };
-  std::vector<CarInit> initial_cars_{{ {0, 70.0, 0.0, 0} }};
+  struct CarInit {
+    CarId id; double speed_mps; double s0; std::uint64_t laps0; double lateral0; double perf;
+  };
+  std::vector<CarInit> initial_cars_{{ {0, 70.0, 0.0, 0, 0.0, 1.0} }};
+  void add_initial_cars_(SimServer& sim) const;
 
   // Hot reseed / preset change control
   std::atomic<bool> pending_reset_{false};
   std::atomic<std::size_t> pending_reset_n_{0};
   std::atomic<bool> pending_preset_change_{false};
   std::atomic<int>  pending_preset_{-1};
+  std::atomic<bool> pending_summary_{false};
+  std::atomic<int>  pending_record_{-1}; // -1 none, 0 stop, 1 start
+  std::atomic<std::size_t> mini_sectors_{25};
 };
 
 } // namespace f1tm
@@ -15,6 +15,7 @@ struct CarPose {
   double heading_rad{};
   double s{};
   std::uint64_t lap{};
+  double speed_mps{};
 
   // Telemetry (server-filled; -1.0 means "unknown/not set yet")
   double last_lap_time{-1.0};
@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include <f1tm/track_geom.hpp>
+
+namespace f1tm {
+
+// Vehicle limits used to derive a reference speed trace from track geometry.
+struct SpeedProfileParams {
+  double v_max_mps = 90.0;          // top speed on straights
+  double a_lat_mps2 = 40.0;         // cornering grip (~4 g)
+  double a_accel_mps2 = 10.0;       // longitudinal acceleration
+  double a_brake_mps2 = 40.0;       // longitudinal braking
+  double ds_m = 1.0;                // table resolution along the lap
+  double curvature_window_m = 8.0;  // half-span for the 3-point curvature estimate
+};
+
+// Reference speed by arclength for one closed TrackPath, built once and then
+// read with a single table lookup per car per tick.
+//
+// Build: curvature (Menger, 3 points over +-window) -> cornering limit
+// v = sqrt(a_lat / k) capped at v_max -> forward acceleration pass ->
+// backward braking pass. Passes wrap around the lap so the trace is closed.
+class SpeedProfile {
+public:
+  SpeedProfile() = default;
+  static SpeedProfile build(const TrackPath& path, const SpeedProfileParams& params = {});
+
+  bool empty() const { return v_.empty(); }
+  double length() const { return length_; }
+  std::size_t size() const { return v_.size(); }
+  const std::vector<double>& speeds() const { return v_; }
+  const std::vector<double>& curvature() const { return k_; }
+
+  // Target speed at s (wrapped into [0, length)); nearest lower table entry.
+  double speed_at(double s) const {
+    if (v_.empty()) return 0.0;
+    double sw = s - length_ * static_cast<double>(static_cast<long long>(s * inv_length_));
+    if (sw < 0.0) sw += length_;
+    std::size_t i = static_cast<std::size_t>(sw * inv_ds_);
+    if (i >= v_.size()) i = v_.size() - 1;
+    return v_[i];
+  }
+
+  // Ideal lap time at performance factor 1.0 (sum of ds / v).
+  double lap_time() const { return lap_time_; }
+
+private:
+  std::vector<double> v_;  // speed per table cell
+  std::vector<double> k_;  // curvature per table cell (1/m)
+  double length_{0.0};
+  double inv_length_{0.0};
+  double inv_ds_{0.0};
+  double lap_time_{0.0};
+};
+
+} // namespace f1tm
@@ -0,0 +1,57 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace f1tm {
+
+// Bounded single-producer single-consumer queue. Lock-free, wait-free per call;
+// capacity is rounded up to a power of two. The producer never blocks: a full
+// ring makes try_push return false.
+template <class T>
+class SpscRing {
+public:
+  explicit SpscRing(std::size_t capacity = 1024) {
+    std::size_t cap = 2;
+    while (cap < capacity) cap <<= 1;
+    buf_.resize(cap);
+    mask_ = cap - 1;
+  }
+
+  std::size_t capacity() const { return buf_.size(); }
+
+  // Producer side
+  bool try_push(const T& v) {
+    const auto h = head_.load(std::memory_order_relaxed);
+    if (h - tail_.load(std::memory_order_acquire) >= buf_.size()) return false;
+    buf_[h & mask_] = v;
+    head_.store(h + 1, std::memory_order_release);
+    return true;
+  }
+  std::size_t write_available() const {
+    return buf_.size() - static_cast<std::size_t>(head_.load(std::memory_order_relaxed) -
+                                                  tail_.load(std::memory_order_acquire));
+  }
+
+  // Consumer side
+  bool try_pop(T& out) {
+    const auto t = tail_.load(std::memory_order_relaxed);
+    if (t == head_.load(std::memory_order_acquire)) return false;
+    out = buf_[t & mask_];
+    tail_.store(t + 1, std::memory_order_release);
+    return true;
+  }
+  std::size_t read_available() const {
+    return static_cast<std::size_t>(head_.load(std::memory_order_acquire) -
+                                    tail_.load(std::memory_order_relaxed));
+  }
+
+private:
+  std::vector<T> buf_;
+  std::size_t mask_{0};
+  alignas(64) std::atomic<std::uint64_t> head_{0}; // written by producer
+  alignas(64) std::atomic<std::uint64_t> tail_{0}; // written by consumer
+};
+
+} // namespace f1tm
@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace f1tm {
+
+// Streaming mean/variance (Welford) with min/max. O(1) memory.
+class RunningStats {
+public:
+  void add(double x);
+  std::uint64_t count() const { return n_; }
+  double mean() const { return n_ ? mean_ : 0.0; }
+  double variance() const { return n_ > 1 ? m2_ / double(n_ - 1) : 0.0; } // sample variance
+  double stddev() const;
+  double min() const { return n_ ? min_ : 0.0; }
+  double max() const { return n_ ? max_ : 0.0; }
+  double sum() const { return sum_; }
+
+private:
+  std::uint64_t n_{0};
+  double mean_{0.0};
+  double m2_{0.0};
+  double min_{0.0};
+  double max_{0.0};
+  double sum_{0.0};
+};
+
+// P-square single-quantile estimator (Jain & Chlamtac): five markers, O(1) memory.
+// Exact while fewer than five samples have been seen.
+class P2Quantile {
+public:
+  explicit P2Quantile(double p = 0.5);
+  void add(double x);
+  double value() const;
+  double p() const { return p_; }
+  std::uint64_t count() const { return n_; }
+
+private:
+  double p_;
+  std::uint64_t n_{0};
+  double q_[5]{};      // marker heights
+  double pos_[5]{};    // actual marker positions (1-based)
+  double want_[5]{};   // desired marker positions
+  double dwant_[5]{};  // desired position increments
+};
+
+// Fixed-size summary of a stream of times: moments, extremes, median and p90.
+struct TimeStats {
+  RunningStats moments{};
+  P2Quantile p50{0.5};
+  P2Quantile p90{0.9};
+
+  void add(double x) { moments.add(x); p50.add(x); p90.add(x); }
+  std::uint64_t count() const { return moments.count(); }
+};
+
+} // namespace f1tm
@@ -0,0 +1,51 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <f1tm/stint.hpp>
+#include <f1tm/track.hpp>
+
+namespace f1tm {
+
+// Tyre compound: base lap time and linear degradation (the estimate_stint_time model).
+struct Compound {
+  std::string name;          // e.g., "S", "M", "H"
+  double baseLap = 0.0;      // seconds, > 0
+  double degradationPerLap = 0.0; // seconds per lap, >= 0
+  int maxLaps = 0;           // longest usable stint; 0 = unlimited
+};
+
+struct StrategySearchOptions {
+  int max_stops = 3;
+  std::size_t top_k = 5;
+  int min_stint_laps = 1;
+  bool require_two_compounds = true; // dry-race rule: at least two different compounds
+  double lane_factor = 1.0;          // applied to every stop (see pit_stop_loss_under)
+};
+
+struct StintPlan {
+  std::size_t compound = 0;  // index into the compound list
+  int laps = 0;
+};
+
+struct PitStrategy {
+  double total_time = 0.0;   // stints + stops, seconds
+  std::vector<StintPlan> stints;
+  int stops() const { return stints.empty() ? 0 : int(stints.size()) - 1; }
+};
+
+// Expand a plan into StintParams (for race_time_with_track / StrategyBatch).
+std::vector<StintParams> strategy_stints(const PitStrategy& s, const std::vector<Compound>& compounds);
+
+// Exact top-K search over stint splits and compounds. Stint times are additive and every
+// stop costs the same, so only the multiset of (compound, laps) stints matters: each is
+// enumerated once, stints ordered by compound index (then longest first). Depth-first
+// branch-and-bound; the bound for the unplanned laps is a DP table of the best
+// completion with the remaining stops (compound rules relaxed), so pruning is exact.
+// Results are sorted by total_time. Empty if inputs are invalid or nothing is feasible.
+std::vector<PitStrategy> optimize_pit_strategy(int race_laps,
+                                               const Track& track,
+                                               const std::vector<Compound>& compounds,
+                                               const StrategySearchOptions& opt = {});
+
+} // namespace f1tm
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstddef>
+#include <optional>
+#include <vector>
+#include <f1tm/pit.hpp>
+#include <f1tm/stint.hpp>
+
+namespace f1tm {
+
+// Editable strategy with cached per-stint and per-stop contributions. Terms are kept in
+// race order (stint 0, stop 0, stint 1, ...) in a Fenwick tree, so one edit costs
+// O(log n), total() and elapsed-time queries are prefix sums, and every edit reports
+// its delta. Same clamps as race_time_with_pits_under; totals agree with it to rounding.
+class StrategyModel {
+public:
+  // Same validation as race_time_with_pits_under; lane_factors empty means all 1.0.
+  static std::optional<StrategyModel> create(std::vector<StintParams> stints,
+                                             std::vector<PitParams> pits,
+                                             std::vector<double> lane_factors = {});
+
+  std::size_t stint_count() const { return stints_.size(); }
+  std::size_t stop_count() const { return pits_.size(); }
+  const StintParams& stint(std::size_t i) const { return stints_[i]; }
+  const PitParams& stop(std::size_t i) const { return pits_[i]; }
+  double lane_factor(std::size_t i) const { return factors_[i]; }
+  int total_laps() const { return laps_; }
+
+  double total() const { return prefix_(terms_.size()); }
+  double stint_time(std::size_t i) const { return terms_[2 * i]; }
+  double stop_time(std::size_t i) const { return terms_[2 * i + 1]; }
+  // Race time when car enters the pit for stop i (stints 0..i, stops 0..i-1).
+  double time_at_stop(std::size_t i) const { return prefix_(2 * i + 1); }
+
+  // Edits return total() after minus before. Out-of-range indices are rejected (nullopt).
+  std::optional<double> set_stint(std::size_t i, const StintParams& s); // e.g., compound swap
+  std::optional<double> set_stint_laps(std::size_t i, int laps);
+  std::optional<double> set_stop(std::size_t i, const PitParams& p);
+  std::optional<double> set_lane_factor(std::size_t i, double f);
+  // Move stop i by `laps` (positive = later): stint i grows, stint i + 1 shrinks.
+  // Rejected if either stint would become negative.
+  std::optional<double> move_stop(std::size_t i, int laps);
+
+  // Delta of move_stop without applying it (O(1)).
+  std::optional<double> move_stop_delta(std::size_t i, int laps) const;
+
+  std::vector<StintParams> stints() const { return stints_; }
+  std::vector<PitParams> pits() const { return pits_; }
+
+private:
+  StrategyModel() = default;
+
+  double set_term_(std::size_t k, double v); // returns v - old
+  double prefix_(std::size_t n) const;       // sum of terms [0, n)
+
+  std::vector<StintParams> stints_;
+  std::vector<PitParams> pits_;
+  std::vector<double> factors_;
+  std::vector<double> terms_;   // race order
+  std::vector<double> tree_;    // Fenwick over terms_, 1-based
+  int laps_{0};
+};
+
+} // namespace f1tm
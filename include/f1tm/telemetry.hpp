@@ -1,7 +1,11 @@
 #pragma once
-#include <unordered_map>
+#include <cstddef>
 #include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
 #include <f1tm/sim.hpp>
+#include <f1tm/stats.hpp>
 
 namespace f1tm {
 
@@ -9,122 +13,134 @@ struct TelemetryTimes {
   double last_lap{-1.0};
   double best_lap{-1.0};
   std::uint64_t laps{0};
+  double lap_line_time{-1.0}; // interpolated time of the latest lap-line crossing
   // Sector times
   double s_last[3]{-1.0,-1.0,-1.0};
   double s_best[3]{-1.0,-1.0,-1.0};
+  // Mini-sector times (views into the sink; valid until its next update)
+  std::span<const double> mini_last{};
+  std::span<const double> mini_best{};
 };
 
-class TelemetrySink {
+// Snapshot of a TimeStats stream.
+struct TimeSummary {
+  std::uint64_t count{0};
+  double mean{-1.0};
+  double stddev{0.0};
+  double min{-1.0};
+  double max{-1.0};
+  double p50{-1.0};
+  double p90{-1.0};
+  static TimeSummary from(const TimeStats& ts);
+};
+
+struct CarSummary {
+  CarId id{};
+  std::uint64_t laps{0};
+  double total_time{0.0};   // sum of timed laps
+  TimeSummary lap{};
+  TimeSummary sector[3]{};
+};
+
+// Immutable end-of-race summary, cars ordered by race progress (leader first).
+class RaceSummary {
 public:
-  void init_if_needed(const class SimServer& sim, double now_time) {
-    if (initialized_) return;
-    initialized_ = true;
-    const std::size_t n = sim.car_count();
-    for (std::size_t i = 0; i < n; ++i) {
-      if (const auto* c = sim.car_by_index(i)) {
-        State st{};
-        st.lap_start_time = now_time; // will be reset on first crossing
-        st.sector_start_time = now_time;
-        st.laps = c->laps;
-        st.started = false;           // ignore first increment; start timing from there
-        st.last_s = c->s;
-        st.next_sector_idx = 0;
-        cars_[c->id] = st;
-      }
-    }
-  }
+  RaceSummary() = default;
+  RaceSummary(double finish_time, std::vector<CarSummary> cars)
+    : finish_time_(finish_time), cars_(std::move(cars)) {}
 
-  void update(const class SimServer& sim, double now_time) {
-    init_if_needed(sim, now_time);
-    const double C = sim.track_length();
-    const double S1 = C / 3.0;
-    const double S2 = 2.0 * C / 3.0;
-
-    const std::size_t n = sim.car_count();
-    for (std::size_t i = 0; i < n; ++i) {
-      const auto* c = sim.car_by_index(i);
-      if (!c) continue;
-      auto& st = cars_[c->id]; // default constructed if not present
-
-      const double prev_prog = st.laps * C + st.last_s;
-      const double now_prog  = c->laps * C + c->s;
-
-      // Process sector boundaries S1 and S2 (S3 handled at lap increment)
-      if (st.started) {
-        // Evaluate whether we've crossed S1 or S2; possibly more than one if dt large
-        while (st.next_sector_idx < 2) {
-          const double boundary_m = st.laps * C + ((st.next_sector_idx == 0) ? S1 : S2);
-          if (now_prog >= boundary_m - 1e-9) {
-            const double sector_time = now_time - st.sector_start_time;
-            st.s_last[st.next_sector_idx] = sector_time;
-            if (st.s_best[st.next_sector_idx] < 0.0 || sector_time < st.s_best[st.next_sector_idx]) {
-              st.s_best[st.next_sector_idx] = sector_time;
-            }
-            st.sector_start_time = now_time;
-            ++st.next_sector_idx;
-          } else {
-            break;
-          }
-        }
-      }
-
-      // Detect lap completion via lap counter increment
-      if (c->laps > st.laps) {
-        if (!st.started) {
-          // First time crossing start/finish; start timing from *now* and do not emit a lap or S3.
-          st.started = true;
-          st.lap_start_time = now_time;
-          st.sector_start_time = now_time;
-          st.next_sector_idx = 0;
-        } else {
-          // Complete S3
-          const double s3_time = now_time - st.sector_start_time;
-          st.s_last[2] = s3_time;
-          if (st.s_best[2] < 0.0 || s3_time < st.s_best[2]) {
-            st.s_best[2] = s3_time;
-          }
-          // Complete lap
-          const double lap_time = now_time - st.lap_start_time;
-          st.last_lap_time = lap_time;
-          if (st.best_lap_time < 0.0 || lap_time < st.best_lap_time) {
-            st.best_lap_time = lap_time;
-          }
-          // Reset for next lap
-          st.lap_start_time = now_time;
-          st.sector_start_time = now_time;
-          st.next_sector_idx = 0;
-        }
-        st.laps = c->laps;
-      }
-
-      st.last_s = c->s;
-    }
+  double finish_time() const { return finish_time_; }
+  const std::vector<CarSummary>& cars() const { return cars_; }
+  const CarSummary* find(CarId id) const {
+    for (const auto& c : cars_) if (c.id == id) return &c;
+    return nullptr;
   }
 
-  bool get(CarId id, TelemetryTimes& out) const {
-    auto it = cars_.find(id);
-    if (it == cars_.end()) return false;
-    out.last_lap = it->second.last_lap_time;
-    out.best_lap = it->second.best_lap_time;
-    out.laps     = it->second.laps;
-    for (int k=0;k<3;++k) { out.s_last[k] = it->second.s_last[k]; out.s_best[k] = it->second.s_best[k]; }
-    return true;
-  }
+private:
+  double finish_time_{0.0};
+  std::vector<CarSummary> cars_{};
+};
+
+// Server-side lap/sector timing. Dense per-slot state (slot == SimServer car index)
+// and a sorted table of timing lines: mini-sector lines merged with the three
+// classic sector lines at C/3 and 2C/3, ending at the lap line. Mini-sector times
+// are per requested mini-sector; a sector line that is not also a mini-sector line
+// does not split one. Each slot caches the progress of its next line, so a tick
+// without a crossing is one compare per car.
+// Crossing times are interpolated between the previous and current tick's progress,
+// so timing does not depend on the tick rate or time warp. Lap and sector times also
+// feed fixed-size streaming aggregates (see stats.hpp) for the RaceSummary.
+// Not thread-safe; owned by the server thread.
+class TelemetrySink {
+public:
+  static constexpr int kSectors = 3;
+
+  // mini_sectors: equal-length timing segments per lap (>= 1). Sector lines are
+  // added where they do not coincide with a mini-sector line.
+  explicit TelemetrySink(std::size_t mini_sectors = kSectors);
+
+  void init_if_needed(const SimServer& sim, double now_time);
+  void update(const SimServer& sim, double now_time);
+
+  // Lookup by SimServer car index (O(1)) or by id (linear; fine for small N).
+  bool get_index(std::size_t idx, TelemetryTimes& out) const;
+  bool get(CarId id, TelemetryTimes& out) const;
+
+  // Streaming aggregates for one slot (nullptr if out of range).
+  const TimeStats* lap_stats(std::size_t idx) const;
+  const TimeStats* sector_stats(std::size_t idx, int sector) const;
+
+  // Build the end-of-race summary at finish_time.
+  RaceSummary summary(double finish_time) const;
+
+  // As requested; TelemetryTimes::mini_last/mini_best have this many entries.
+  std::size_t mini_sector_count() const { return mini_sectors_; }
+  // Timing lines: mini-sector lines plus any sector line not among them.
+  std::size_t line_count() const { return fractions_.size(); }
+  // Timing-line positions as lap fractions, sorted, ending with 1.0 (the lap line).
+  const std::vector<double>& line_fractions() const { return fractions_; }
 
 private:
+  struct Line {
+    double s_m{0.0};   // distance from start/finish
+    int sector_end{-1}; // classic sector ended by this line, or -1
+    int mini_end{-1};   // mini-sector ended by this line, or -1
+  };
   struct State {
     double lap_start_time{0.0};
     double sector_start_time{0.0};
+    double mini_start_time{0.0};
     double last_lap_time{-1.0};
     double best_lap_time{-1.0};
+    double lap_line_time{-1.0};
+    double lap_base{0.0};        // progress (m) at the start of the current lap
+    double next_line_prog{0.0};  // progress (m) of the next timing line
+    double prev_prog{0.0};       // progress (m) and time at the previous update
+    double prev_time{0.0};
     std::uint64_t laps{0};
-    double last_s{0.0};
+    std::uint32_t next_line{0};
     bool started{false};
-    int  next_sector_idx{0}; // 0->S1, 1->S2, (S3 handled at lap)
-    double s_last[3]{-1.0,-1.0,-1.0};
-    double s_best[3]{-1.0,-1.0,-1.0};
+    double s_last[kSectors]{-1.0,-1.0,-1.0};
+    double s_best[kSectors]{-1.0,-1.0,-1.0};
   };
-  std::unordered_map<CarId, State> cars_;
+
+  void build_lines_(double C);
+  void add_slot_(const CarState& c, double now_time);
+  void cross_line_(std::size_t slot, double t);
+
+  std::vector<double> fractions_;  // sorted, last == 1.0
+  std::vector<int> sector_end_;    // per fraction
+  std::vector<int> mini_end_;      // per fraction
+  std::size_t mini_sectors_{0};
+  std::vector<Line> lines_;        // meters; built on first update
+  double C_{0.0};
+
+  std::vector<CarId>  ids_;        // per slot
+  std::vector<State>  st_;         // per slot
+  std::vector<double> mini_last_;  // slot * mini_sectors_ + k
+  std::vector<double> mini_best_;
+  std::vector<TimeStats> lap_stats_;     // per slot
+  std::vector<TimeStats> sector_stats_;  // slot * kSectors + k
   bool initialized_{false};
 };
 
@@ -0,0 +1,66 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+namespace f1tm {
+
+// What a fixed-rate loop does once it is a whole period or more behind schedule.
+enum class CatchUpPolicy : std::uint8_t {
+  Burst,    // run the missed ticks back to back; sim time keeps wall time
+  Drop,     // skip the missed ticks and fold their time into one larger step
+  SlowDown, // forget the missed ticks; sim time falls behind wall time
+};
+
+// Tick-budget counters, written by the ticking thread and readable from any thread.
+struct TickStats {
+  std::atomic<std::uint64_t> ticks{0};
+  std::atomic<std::uint64_t> overruns{0};      // work finished after the next tick was due
+  std::atomic<std::uint64_t> late_ticks{0};    // started a whole period or more behind
+  std::atomic<std::uint64_t> bursts{0};        // runs of consecutive late ticks (Burst)
+  std::atomic<std::uint64_t> dropped_ticks{0}; // periods folded into a longer step (Drop)
+  std::atomic<std::uint64_t> resyncs{0};       // schedule re-anchored to now (SlowDown)
+  std::atomic<std::uint64_t> work_ns_last{0};
+  std::atomic<std::uint64_t> work_ns_max{0};
+  std::atomic<std::uint64_t> work_ns_total{0};
+  std::atomic<std::uint64_t> overshoot_ns_last{0}; // woke this long after the deadline
+  std::atomic<std::uint64_t> overshoot_ns_max{0};
+  std::atomic<double> tick_hz{0.0};                // ticks (and publishes) per second, ~1 s window
+
+  void reset();
+};
+
+// Fixed-period schedule in integer nanoseconds (any monotonic clock). Per tick:
+//   periods = begin_tick(now);  // step the sim by periods * dt
+//   wake = end_tick(now);       // sleep until wake
+//   woke(now);
+// The caller owns the clock and the sleep, so tests can drive it with made-up times.
+class TickScheduler {
+public:
+  static constexpr std::uint32_t kMaxFoldedPeriods = 8; // Drop: longest single step
+
+  TickScheduler(TickStats& stats, std::int64_t period_ns, CatchUpPolicy policy = CatchUpPolicy::Burst)
+    : stats_(stats), period_(period_ns), policy_(policy) {}
+
+  void start(std::int64_t now_ns);
+  void set_policy(CatchUpPolicy p) { policy_ = p; }
+  CatchUpPolicy policy() const { return policy_; }
+
+  std::uint32_t begin_tick(std::int64_t now_ns);
+  std::int64_t end_tick(std::int64_t now_ns);
+  void woke(std::int64_t now_ns);
+
+  std::int64_t deadline() const { return deadline_; }
+
+private:
+  TickStats& stats_;
+  std::int64_t period_;
+  CatchUpPolicy policy_;
+  std::int64_t deadline_{0};   // scheduled start of the current (then next) tick
+  std::int64_t tick_start_{0};
+  bool in_burst_{false};
+  bool slept_{false};
+  std::int64_t window_start_{0};
+  std::uint64_t window_ticks_{0};
+};
+
+} // namespace f1tm
@@ -1,6 +1,7 @@
 #pragma once
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <istream>
 #include <f1tm/pit.hpp>
@@ -29,7 +30,13 @@ std::optional<Track> track_by_key_in(const std::vector<Track>& cat, const std::s
 // Whitespace around fields is trimmed. Invalid rows are skipped.
 std::vector<Track> track_catalog_from_csv_stream(std::istream& in);
 
-// Filesystem wrapper; returns nullopt if file cannot be opened.
+// Same rules over an in-memory buffer: fields are string_views into text and numbers
+// are parsed with std::from_chars, so the only allocation per row is the Track key.
+// The stream and file loaders use this.
+std::vector<Track> track_catalog_from_csv(std::string_view text);
+
+// Filesystem wrapper; returns nullopt if file cannot be opened. The file is
+// memory-mapped and parsed in place.
 std::optional<std::vector<Track>> load_track_catalog_csv(const std::string& path);
 
 // Convenience: derive PitParams from a Track.
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+#include <f1tm/track.hpp>
+
+namespace f1tm {
+
+// Dense index of a track within its TrackCatalog (insertion order).
+using TrackId = std::uint32_t;
+
+// 32-bit FNV-1a of the key, over ASCII-lower-cased bytes with fold_case. Part of the
+// compiled catalog format (track_catalog_file.hpp); do not change.
+std::uint32_t track_key_hash(std::string_view key, bool fold_case);
+// Key equality under the same folding.
+bool track_key_equal(std::string_view a, std::string_view b, bool fold_case);
+
+// Immutable, hashed track catalog. Lookups take a string_view (no key copies) and
+// hand out a TrackId or a const Track*; both stay valid for the catalog's lifetime,
+// including across moves. With fold_case, keys match ASCII case-insensitively.
+// Duplicate keys keep the first track, like track_by_key_in.
+class TrackCatalog {
+public:
+  TrackCatalog() = default;
+  explicit TrackCatalog(std::vector<Track> tracks, bool fold_case = false);
+
+  std::optional<TrackId> id(std::string_view key) const;
+  const Track* find(std::string_view key) const;
+  const Track& operator[](TrackId id) const { return tracks_[id]; }
+
+  std::size_t size() const { return tracks_.size(); }
+  bool empty() const { return tracks_.empty(); }
+  bool fold_case() const { return fold_case_; }
+  std::span<const Track> tracks() const { return tracks_; }
+
+private:
+  struct Slot {
+    std::uint32_t hash{0};
+    TrackId id{kEmpty};
+  };
+  static constexpr TrackId kEmpty = ~TrackId{0};
+
+  std::vector<Track> tracks_;
+  std::vector<Slot> slots_;  // open addressing, linear probing, power-of-two size
+  bool fold_case_{false};
+};
+
+// Index over track_catalog() (case-insensitive).
+const TrackCatalog& builtin_track_catalog();
+
+} // namespace f1tm
@@ -0,0 +1,107 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <f1tm/mapped_file.hpp>
+#include <f1tm/track.hpp>
+#include <f1tm/track_catalog.hpp>
+
+namespace f1tm {
+
+// Compiled track catalog (.f1cat), little-endian, 8-byte aligned sections:
+//   CatFileHeader, CatRecord[track_count], CatSlot[slot_count], key bytes.
+// Records keep catalog order (record i is TrackId i). Slots are an open-addressing
+// index (linear probing, power-of-two size, id 0xFFFFFFFF = empty) on track_key_hash.
+// The header stamps the source CSV (size, mtime, content hash) for invalidation.
+
+inline constexpr char kCatMagic[8] = {'F','1','T','M','C','A','T','1'};
+inline constexpr std::uint32_t kCatVersion = 1;
+inline constexpr std::uint32_t kCatFoldCase = 1u; // CatFileHeader::flags
+
+struct CatSourceStamp {
+  std::uint64_t size{0};
+  std::int64_t mtime{0};  // filesystem clock ticks
+  std::uint64_t hash{0};  // catalog_source_hash of the bytes
+};
+
+struct CatFileHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t flags;
+  CatSourceStamp source;
+  std::uint32_t track_count;
+  std::uint32_t slot_count;
+  std::uint64_t key_bytes;
+};
+
+struct CatRecord {
+  std::uint32_t key_offset;  // into the key bytes
+  std::uint32_t key_size;
+  double pit_stationary_s;
+  double pit_lane_delta_s;
+  double sc_lane_factor;
+  double vsc_lane_factor;
+};
+
+struct CatSlot {
+  std::uint32_t hash;
+  std::uint32_t id;
+};
+static_assert(sizeof(CatFileHeader) == 56);
+static_assert(sizeof(CatRecord) == 40);
+static_assert(sizeof(CatSlot) == 8);
+
+// 64-bit content hash used in CatSourceStamp (8 bytes per step).
+std::uint64_t catalog_source_hash(const void* data, std::size_t size);
+
+// Writes a uniquely named temporary file (exclusive create) and renames it into place,
+// so readers never see a partial file, even with several writers at once.
+bool write_compiled_track_catalog(const std::string& path, const std::vector<Track>& tracks,
+                                  const CatSourceStamp& source, bool fold_case = true);
+
+// Memory-mapped .f1cat. open() checks the header and section bounds only, so it is
+// O(1) in the catalog size; lookups probe the mapped index and read records in place.
+class CompiledTrackCatalog {
+public:
+  bool open(const std::string& path); // false if missing, not an .f1cat or truncated
+  void close();
+  bool is_open() const { return file_.data() != nullptr; }
+
+  const CatFileHeader& header() const { return hdr_; }
+  std::size_t size() const { return hdr_.track_count; }
+  bool fold_case() const { return (hdr_.flags & kCatFoldCase) != 0; }
+
+  std::string_view key(TrackId id) const;
+  Track track(TrackId id) const;
+  std::optional<TrackId> id(std::string_view key) const;
+  std::optional<Track> find(std::string_view key) const;
+  std::vector<Track> tracks() const;
+
+private:
+  CatRecord record_(TrackId id) const;
+
+  MappedFile file_;
+  CatFileHeader hdr_{};
+  const std::uint8_t* records_{nullptr};
+  const std::uint8_t* slots_{nullptr};
+  const char* keys_{nullptr};
+};
+
+enum class CatalogCacheResult {
+  Hit,        // stamp matched on size and mtime; the CSV was not read
+  Restamped,  // mtime changed but content hash matched; header rewritten, no parse
+  Rebuilt,    // missing, stale or unreadable cache; CSV parsed and recompiled
+};
+
+// Opens cache_path for csv_path, rebuilding it when the CSV's size, mtime or content
+// hash no longer match the stamp (or fold_case differs). nullopt if the CSV cannot be
+// read or the cache cannot be written.
+std::optional<CatalogCacheResult> open_track_catalog_cached(const std::string& csv_path,
+                                                            const std::string& cache_path,
+                                                            CompiledTrackCatalog& out,
+                                                            bool fold_case = true);
+
+} // namespace f1tm
@@ -24,7 +24,9 @@ public:
 
   void set_points(std::vector<Vec2> pts) {
     pts_ = std::move(pts);
-    if (pts_.size() < 2) { pts_.clear(); cum_.clear(); length_ = 0.0; return; }
+    if (pts_.size() < 2) {
+      pts_.clear(); cum_.clear(); nrm_.clear(); hdg_.clear(); length_ = 0.0; return;
+    }
     // Ensure closed (repeat first at end if not equal)
     if (pts_.front().x != pts_.back().x || pts_.front().y != pts_.back().y) {
       pts_.push_back(pts_.front());
@@ -38,31 +40,38 @@ public:
 
   // Sample s in [0, length) to world position and heading (tangent angle).
   void sample_pose(double s, double& x, double& y, double& heading_rad) const {
-    if (empty() || length_ <= 0.0) { x = y = heading_rad = 0.0; return; }
-    // wrap s
-    double sw = std::fmod(s, length_);
-    if (sw < 0.0) sw += length_;
-
-    // Find segment via binary search
-    auto it = std::upper_bound(cum_.begin(), cum_.end(), sw);
-    std::size_t i1 = std::clamp<std::size_t>(std::distance(cum_.begin(), it), 1, pts_.size()-1);
-    std::size_t i0 = i1 - 1;
+    sample_pose(s, 0.0, x, y, heading_rad);
+  }
 
-    const double s0 = cum_[i0];
-    const double seg_len = cum_[i1] - cum_[i0];
-    const double t = (seg_len > 0.0) ? (sw - s0) / seg_len : 0.0;
+  // Sample with a lateral offset (meters, +left of travel direction) along the
+  // precomputed segment normal. Heading is the cached segment tangent: no trig per call.
+  void sample_pose(double s, double lateral, double& x, double& y, double& heading_rad) const {
+    if (empty() || length_ <= 0.0) { x = y = heading_rad = 0.0; return; }
+    const std::size_t i0 = segment_at_(s, s);
+    const double seg_len = cum_[i0 + 1] - cum_[i0];
+    const double t = (seg_len > 0.0) ? (s - cum_[i0]) / seg_len : 0.0;
 
     const Vec2& a = pts_[i0];
-    const Vec2& b = pts_[i1];
+    const Vec2& b = pts_[i0 + 1];
+    const Vec2& n = nrm_[i0];
 
-    x = a.x + (b.x - a.x) * t;
-    y = a.y + (b.y - a.y) * t;
+    x = a.x + (b.x - a.x) * t + n.x * lateral;
+    y = a.y + (b.y - a.y) * t + n.y * lateral;
+    heading_rad = hdg_[i0];
+  }
 
-    const double dx = (b.x - a.x);
-    const double dy = (b.y - a.y);
-    heading_rad = std::atan2(dy, dx);
+  // Batch form: n samples from parallel arrays. `lateral` may be nullptr (centerline).
+  void sample_poses(const double* s, const double* lateral, std::size_t n,
+                    double* x, double* y, double* heading_rad) const {
+    for (std::size_t i = 0; i < n; ++i) {
+      sample_pose(s[i], lateral ? lateral[i] : 0.0, x[i], y[i], heading_rad[i]);
+    }
   }
 
+  // Unit left normal and tangent angle of segment i (pts[i] -> pts[i+1]).
+  const std::vector<Vec2>& segment_normals() const { return nrm_; }
+  const std::vector<double>& segment_headings() const { return hdg_; }
+
   // Factory: rounded-rectangle "stadium" track centered at (0,0)
   // straight_len: length of each straight section (centerline)
   // radius: corner radius (centerline)
@@ -142,19 +151,36 @@ private:
     };
   }
 
+  // Wrap s into [0, length) and return the index of the segment containing it.
+  std::size_t segment_at_(double s, double& sw) const {
+    sw = std::fmod(s, length_);
+    if (sw < 0.0) sw += length_;
+    auto it = std::upper_bound(cum_.begin(), cum_.end(), sw);
+    const std::size_t i1 = std::clamp<std::size_t>(
+        static_cast<std::size_t>(std::distance(cum_.begin(), it)), 1, pts_.size()-1);
+    return i1 - 1;
+  }
+
   void build_cumulative_() {
     cum_.resize(pts_.size());
+    nrm_.assign(pts_.size() - 1, Vec2{});
+    hdg_.assign(pts_.size() - 1, 0.0);
     cum_[0] = 0.0;
     for (std::size_t i = 1; i < pts_.size(); ++i) {
       const double dx = pts_[i].x - pts_[i-1].x;
       const double dy = pts_[i].y - pts_[i-1].y;
-      cum_[i] = cum_[i-1] + std::sqrt(dx*dx + dy*dy);
+      const double len = std::sqrt(dx*dx + dy*dy);
+      cum_[i] = cum_[i-1] + len;
+      hdg_[i-1] = std::atan2(dy, dx);
+      if (len > 0.0) nrm_[i-1] = Vec2{ -dy / len, dx / len };
     }
     length_ = cum_.back();
   }
 
   std::vector<Vec2> pts_;
   std::vector<double> cum_;
+  std::vector<Vec2>   nrm_;   // per-segment unit left normal
+  std::vector<double> hdg_;   // per-segment tangent angle
   double length_{0.0};
 };
 
@@ -0,0 +1,80 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+#include <f1tm/track_geom.hpp>
+
+namespace f1tm {
+
+// Axis-aligned box; default is empty (overlaps nothing, neutral for expand).
+struct Box2 {
+  float x0{std::numeric_limits<float>::max()}, y0{std::numeric_limits<float>::max()};
+  float x1{std::numeric_limits<float>::lowest()}, y1{std::numeric_limits<float>::lowest()};
+
+  void expand(float x, float y) {
+    if (x < x0) x0 = x;
+    if (y < y0) y0 = y;
+    if (x > x1) x1 = x;
+    if (y > y1) y1 = y;
+  }
+  void expand(const Box2& b) {
+    if (b.x0 < x0) x0 = b.x0;
+    if (b.y0 < y0) y0 = b.y0;
+    if (b.x1 > x1) x1 = b.x1;
+    if (b.y1 > y1) y1 = b.y1;
+  }
+  bool overlaps(const Box2& b) const {
+    return x0 <= b.x1 && b.x0 <= x1 && y0 <= b.y1 && b.y0 <= y1;
+  }
+  bool contains(float x, float y) const { return x >= x0 && x <= x1 && y >= y0 && y <= y1; }
+};
+
+// Coarse bounding-box hierarchy over consecutive runs of segments: leaves are given,
+// each level above unions pairs. Queries return the overlapping leaves as [first, last)
+// runs in leaf order, so callers can draw contiguous ranges.
+class BoxTree {
+public:
+  using Run = std::pair<std::uint32_t, std::uint32_t>;
+
+  void build(std::vector<Box2> leaves);
+  void query(const Box2& view, std::vector<Run>& runs) const; // clears runs first
+
+  std::size_t leaf_count() const { return levels_.empty() ? 0 : levels_.front().size(); }
+  const Box2& leaf(std::size_t i) const { return levels_.front()[i]; }
+
+private:
+  void query_(std::size_t level, std::size_t i, const Box2& view, std::vector<Run>& runs) const;
+
+  std::vector<std::vector<Box2>> levels_; // [0] = leaves, back() = root
+};
+
+// Douglas-Peucker over a closed polyline (first == last): keeps every point farther
+// than tolerance_m from the simplified outline. The result is closed as well.
+std::vector<Vec2> decimate_closed_path(const std::vector<Vec2>& pts, double tolerance_m);
+
+// Precomputed decimations of a path at doubling tolerances, picked by zoom so the
+// outline stays within max_error_px of the full-resolution path on screen.
+class TrackLod {
+public:
+  static constexpr double kBaseToleranceM = 0.01;
+  static constexpr std::size_t kMaxLevels = 14;
+
+  void build(const TrackPath& path);
+  // Level 0 is the full path; each further level doubles the tolerance and keeps fewer
+  // points (levels that would not drop any point are skipped).
+  const std::vector<Vec2>& level(std::size_t k) const { return levels_[k]; }
+  double tolerance_m(std::size_t k) const { return tolerance_[k]; }
+  std::size_t level_count() const { return levels_.size(); }
+  std::size_t level_for(float scale_px_per_m, float max_error_px = 0.5f) const;
+  const std::vector<Vec2>& points_for(float scale_px_per_m, float max_error_px = 0.5f) const {
+    return levels_[level_for(scale_px_per_m, max_error_px)];
+  }
+
+private:
+  std::vector<std::vector<Vec2>> levels_{{}};
+  std::vector<double> tolerance_{0.0};
+};
+
+} // namespace f1tm
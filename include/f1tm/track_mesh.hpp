@@ -0,0 +1,74 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <f1tm/track_geom.hpp>
+#include <f1tm/track_lod.hpp>
+
+namespace f1tm {
+
+struct MeshColor {
+  std::uint8_t r, g, b, a;
+};
+
+struct MeshVertex {
+  float x, y;
+  MeshColor c;
+};
+
+struct TrackMeshParams {
+  float scale_px_per_m = 2.0f;
+  float width_m = 12.0f;
+  int grid_cars = 0;   // grid boxes behind the start line
+};
+
+// Static track scenery as one triangle list: asphalt ribbon (mitred strip), centre
+// seam, kerb dashes on the inner edge, start/finish checker and grid boxes, in draw
+// order. Positions are pixels relative to the world origin with y down (x*s, -y*s),
+// so panning only shifts the draw offset and the mesh depends on the path, zoom and
+// grid size alone. Pixel-sized details (kerb dashes, seam, checker) match the old
+// per-frame drawing. Triangles are counter-clockwise on screen, as raylib expects.
+// No raylib dependency; the viewer uploads vertices to its batch.
+//
+// Ribbon, seam and kerbs are cut into chunks of kChunkSegs segments with a bounding
+// box each (a BoxTree); visible() returns only the vertex ranges that overlap a view
+// box, still in layer order. The outline may be a decimated point set (TrackLod);
+// grid boxes always follow the full path.
+class TrackMesh {
+public:
+  static constexpr std::size_t kChunkSegs = 16;
+
+  struct VertexRange {
+    std::uint32_t begin, end;
+  };
+
+  void build(const TrackPath& path, const TrackMeshParams& p, std::span<const Vec2> outline = {});
+  void clear();
+
+  const std::vector<MeshVertex>& vertices() const { return verts_; } // 3 per triangle
+  std::size_t triangle_count() const { return verts_.size() / 3; }
+  const TrackMeshParams& params() const { return params_; }
+  std::size_t chunk_count() const { return tree_.leaf_count(); }
+
+  // Vertex ranges overlapping view (mesh pixel coordinates), in draw order.
+  void visible(const Box2& view, std::vector<VertexRange>& out) const;
+
+private:
+  struct P { float x, y; };
+  void tri_(P a, P b, P c, MeshColor col);
+  void quad_(P a, P b, P c, P d, MeshColor col);   // a-b-c-d around the edge
+  void line_(P a, P b, float thick, MeshColor col); // same quad as DrawLineEx
+
+  enum Layer { kAsphaltLayer, kSeamLayer, kKerbLayer, kLayers };
+
+  std::vector<MeshVertex> verts_;
+  TrackMeshParams params_{};
+  std::vector<std::uint32_t> chunk_off_[kLayers]; // chunk c is [off[c], off[c+1])
+  std::uint32_t markings_begin_{0};               // checker and grid boxes, to the end
+  Box2 markings_box_{};
+  BoxTree tree_;
+  mutable std::vector<BoxTree::Run> runs_;        // query scratch (render thread only)
+};
+
+} // namespace f1tm
@@ -1,27 +1,44 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
+#include <vector>
 #include <f1tm/interp.hpp>
+#include <f1tm/profiler.hpp>
+#include <f1tm/race_order.hpp>
+#include <f1tm/car_batch.hpp>
 #include <f1tm/snap.hpp>
+#include <f1tm/track_mesh.hpp>
 
 namespace f1tm {
 
 class SimRunner;
+class ReplaySource;
 
 // RAII application that renders the latest snapshots and HUD.
 class ViewerApp {
 public:
-  explicit ViewerApp(SimRunner& sim);
+  // With a replay source the viewer plays the recording instead of the live sim
+  // (the sim still provides the track geometry).
+  explicit ViewerApp(SimRunner& sim, ReplaySource* replay = nullptr);
   int run(); // returns 0 on normal exit
 
+  // Per-frame stage timings (F3 shows p50/p99 next to SimRunner::profiler()).
+  enum Stage : std::size_t {
+    kStageInput, kStagePump, kStageInterp, kStageTrack, kStageCars, kStageDashboard, kStageFrame
+  };
+  const StageProfiler& profiler() const { return profiler_; }
+
 private:
   // Input & data flow
   void process_input_();
   void pump_snapshots_();
+  void process_replay_input_();
   // Rendering
   void render_frame_();
   void draw_track_(float scale_px_per_m);
   void draw_hud_(const SimSnapshot& draw);
-      void draw_dashboard_(const SimSnapshot& draw);
+  void draw_dashboard_();
+  void draw_profiler_();
 
   // Helpers
   struct Vec2f { float x; float y; };
@@ -29,10 +46,32 @@ private:
 
   // Dependencies
   SimRunner& sim_;
+  ReplaySource* replay_{nullptr};
   // Client-side interpolation
   InterpBuffer ibuf_{};
   SimSnapshot last_snap_{};
   std::uint64_t cursor_{0};
+  std::uint64_t summary_cursor_{0};
+
+  // Track scenery, rebuilt only when its key changes (pan is a draw offset)
+  struct TrackMeshKey {
+    int preset{-1};
+    std::size_t points{0};
+    double length{0.0};
+    float scale{0.0f};
+    int grid_cars{-1};
+    bool operator==(const TrackMeshKey&) const = default;
+  };
+  TrackLod track_lod_{};          // per path; picks the outline for the zoom
+  TrackMesh track_mesh_{};
+  TrackMeshKey track_mesh_key_{};
+  std::vector<TrackMesh::VertexRange> track_ranges_; // visible chunks, reused per frame
+  CarBatch car_batch_{};
+  RaceOrder race_order_{};
+
+  // Profiling
+  StageProfiler profiler_{"input", "snapshots", "interp sample", "track", "cars", "dashboard", "frame"};
+  bool show_profiler_{false};
 
   // UI state
   float  scale_px_per_m_{2.0f};
@@ -0,0 +1,93 @@
+#include <f1tm/car_batch.hpp>
+#include <array>
+#include <cmath>
+
+namespace f1tm {
+
+namespace {
+
+// High-contrast palette; assigned per CarId (stable during session).
+constexpr MeshColor kPalette[] = {
+  {231, 76, 60, 255},   // red
+  {52, 152, 219, 255},  // blue
+  {46, 204, 113, 255},  // green
+  {241, 196, 15, 255},  // yellow
+  {155, 89, 182, 255},  // purple
+  {26, 188, 156, 255},  // teal
+  {230, 126, 34, 255},  // orange
+  {236, 112, 99, 255},  // salmon
+  {39, 174, 96, 255},   // dark green
+  {52, 73, 94, 255},    // slate
+  {127, 140, 141, 255}, // gray
+  {241, 90, 36, 255},   // orange-red
+  {0, 152, 117, 255},   // sea green
+  {91, 44, 111, 255},   // deep purple
+  {142, 68, 173, 255},  // amethyst
+  {33, 97, 140, 255},   // steel blue
+};
+constexpr std::uint32_t kPaletteSize = sizeof(kPalette) / sizeof(kPalette[0]);
+
+constexpr float kCarLenPx = 12.0f;   // nose/tail distance from centre
+constexpr float kCarWidPx = 6.0f;    // tail half-width
+constexpr float kMarkerPx = 3.0f;    // centre marker radius
+
+// Unit circle at the marker corners, computed once.
+const std::array<float, 2 * (CarBatch::kMarkerSides + 1)>& marker_dirs() {
+  static const auto dirs = [] {
+    std::array<float, 2 * (CarBatch::kMarkerSides + 1)> d{};
+    for (std::size_t k = 0; k <= CarBatch::kMarkerSides; ++k) {
+      const double a = kTAU * double(k % CarBatch::kMarkerSides) / double(CarBatch::kMarkerSides);
+      d[2*k] = float(std::cos(a));
+      d[2*k + 1] = float(std::sin(a));
+    }
+    return d;
+  }();
+  return dirs;
+}
+
+} // namespace
+
+MeshColor CarColorTable::color(CarId id) {
+  if (id >= kDenseIds) return kPalette[id % kPaletteSize];
+  if (id >= slot_.size()) slot_.resize(std::size_t(id) + 1, kUnassigned);
+  std::uint8_t& s = slot_[id];
+  if (s == kUnassigned) s = static_cast<std::uint8_t>(assigned_++ % kPaletteSize);
+  return kPalette[s];
+}
+
+std::span<const MeshColor> CarColorTable::palette() { return kPalette; }
+
+void CarBatch::build(std::span<const CarPose> cars, float scale, float ox, float oy,
+                     CarColorTable& colors, const Box2* view) {
+  verts_.resize(cars.size() * kVertsPerCar);
+  const auto& dirs = marker_dirs();
+  Box2 keep{};
+  if (view) {
+    // Glyph reaches at most hypot(len, wid) from the centre; kCarLenPx + kCarWidPx covers it.
+    const float m = kCarLenPx + kCarWidPx;
+    keep = Box2{view->x0 - m, view->y0 - m, view->x1 + m, view->y1 + m};
+  }
+  MeshVertex* out = verts_.data();
+  for (const auto& car : cars) {
+    const MeshColor col = colors.color(car.id); // assign even when culled: stable order
+    const float px = ox + float(car.x) * scale;
+    const float py = oy - float(car.y) * scale;
+    if (view && !keep.contains(px, py)) continue;
+    const float c = std::cos(float(car.heading_rad)), s = std::sin(float(car.heading_rad));
+
+    // Heading triangle, counter-clockwise on screen (nose, right tail, left tail).
+    *out++ = {px + c*kCarLenPx, py - s*kCarLenPx, col};
+    *out++ = {px - c*kCarLenPx - s*kCarWidPx, py + s*kCarLenPx - c*kCarWidPx, col};
+    *out++ = {px - c*kCarLenPx + s*kCarWidPx, py + s*kCarLenPx + c*kCarWidPx, col};
+
+    // Centre marker as a small fan (a circle costs 36 triangles in raylib).
+    for (std::size_t k = 0; k < kMarkerSides; ++k) {
+      *out++ = {px, py, col};
+      *out++ = {px + dirs[2*k + 2] * kMarkerPx, py + dirs[2*k + 3] * kMarkerPx, col};
+      *out++ = {px + dirs[2*k] * kMarkerPx, py + dirs[2*k + 1] * kMarkerPx, col};
+    }
+  }
+  verts_.resize(std::size_t(out - verts_.data()));
+}
+
+} // namespace f1tm
@@ -0,0 +1,133 @@
+#include <f1tm/eval_cache.hpp>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+namespace f1tm {
+
+namespace {
+
+std::uint64_t mix(std::uint64_t z) {
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+// Fixed-point at 1e-9, rounded half away from zero (inline; llround is a libm call).
+// Values out of range (or NaN) keep their bit pattern.
+std::uint64_t quantize(double v) {
+  if (!(std::fabs(v) < 1e9)) return std::bit_cast<std::uint64_t>(v);
+  const double x = v * StrategyKey::kScale;
+  return static_cast<std::uint64_t>(static_cast<std::int64_t>(x + (x < 0.0 ? -0.5 : 0.5)));
+}
+
+} // namespace
+
+std::uint64_t StrategyKey::quantized(double v) { return quantize(v); }
+
+void StrategyKey::assign(const std::vector<StintParams>& stints, const Track& track,
+                         const PackedEventStream& events, std::span<const std::uint64_t> context) {
+  const std::size_t key_words = (track.key.size() + 7) / 8;
+  words_.resize(1 + 3 * stints.size() + 1 + key_words + 4 + 1 + events.words().size() + 1 +
+                context.size());
+  std::uint64_t* w = words_.data();
+  *w++ = stints.size();
+  for (const auto& s : stints) {
+    *w++ = static_cast<std::uint64_t>(static_cast<std::int64_t>(s.laps));
+    *w++ = quantize(s.baseLap);
+    *w++ = quantize(s.degradationPerLap);
+  }
+  // Key bytes, 8 per word, so tracks sharing numbers but not names stay distinct.
+  *w++ = track.key.size();
+  for (std::size_t i = 0; i < track.key.size(); i += 8) {
+    std::uint64_t k = 0;
+    std::memcpy(&k, track.key.data() + i, std::min<std::size_t>(8, track.key.size() - i));
+    *w++ = k;
+  }
+  *w++ = quantize(track.pit_stationary_s);
+  *w++ = quantize(track.pit_lane_delta_s);
+  *w++ = quantize(track.sc_lane_factor);
+  *w++ = quantize(track.vsc_lane_factor);
+  *w++ = events.size();
+  for (std::uint64_t e : events.words()) *w++ = e;
+  *w++ = context.size();
+  for (std::uint64_t c : context) *w++ = c;
+
+  // Multiply-rotate per word, one full mix at the end.
+  std::uint64_t h = 0x9E3779B97F4A7C15ull;
+  for (std::uint64_t x : words_) h = std::rotl((h ^ x) * 0xD1B54A32D192ED03ull, 29);
+  hash_ = mix(h ^ words_.size());
+}
+
+EvaluationCache::EvaluationCache(EvalCacheConfig cfg) {
+  const std::size_t n = std::bit_ceil(std::max<std::size_t>(1, cfg.shards));
+  per_shard_ = std::max<std::size_t>(1, (cfg.capacity + n - 1) / n);
+  shards_.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    shards_.push_back(std::make_unique<Shard>());
+    shards_.back()->index.reserve(per_shard_);
+  }
+}
+
+std::optional<double> EvaluationCache::find(const StrategyKey& key) {
+  Shard& sh = shard_(key);
+  std::lock_guard<std::mutex> lk(sh.mu);
+  const auto it = sh.index.find(key.hash());
+  if (it == sh.index.end() || !(it->second->key == key)) {
+    stats_.misses.fetch_add(1, std::memory_order_relaxed);
+    return std::nullopt;
+  }
+  sh.lru.splice(sh.lru.begin(), sh.lru, it->second);
+  stats_.hits.fetch_add(1, std::memory_order_relaxed);
+  return it->second->value;
+}
+
+void EvaluationCache::insert(const StrategyKey& key, double value) {
+  Shard& sh = shard_(key);
+  std::lock_guard<std::mutex> lk(sh.mu);
+  const auto it = sh.index.find(key.hash());
+  if (it != sh.index.end()) {
+    // Same key stored meanwhile, or a hash collision: overwrite in place.
+    it->second->key = key;
+    it->second->value = value;
+    sh.lru.splice(sh.lru.begin(), sh.lru, it->second);
+  } else if (sh.lru.size() < per_shard_) {
+    sh.lru.push_front(Entry{key, value});
+    sh.index.emplace(key.hash(), sh.lru.begin());
+  } else {
+    // Recycle the oldest node (its key storage is reused).
+    const auto last = std::prev(sh.lru.end());
+    sh.index.erase(last->key.hash());
+    last->key = key;
+    last->value = value;
+    sh.lru.splice(sh.lru.begin(), sh.lru, last);
+    sh.index.emplace(key.hash(), sh.lru.begin());
+    stats_.evictions.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+std::size_t EvaluationCache::size() const {
+  std::size_t n = 0;
+  for (const auto& sh : shards_) {
+    std::lock_guard<std::mutex> lk(sh->mu);
+    n += sh->lru.size();
+  }
+  return n;
+}
+
+void EvaluationCache::clear() {
+  for (auto& sh : shards_) {
+    std::lock_guard<std::mutex> lk(sh->mu);
+    sh->lru.clear();
+    sh->index.clear();
+  }
+}
+
+double EvaluationCache::hit_rate() const {
+  const double h = double(stats_.hits.load(std::memory_order_relaxed));
+  const double m = double(stats_.misses.load(std::memory_order_relaxed));
+  return h + m > 0.0 ? h / (h + m) : 0.0;
+}
+
+} // namespace f1tm
@@ -0,0 +1,87 @@
+#include <f1tm/event_stream.hpp>
+#include <algorithm>
+#include <bit>
+#include <cctype>
+
+namespace f1tm {
+
+static inline double clamp01(double x) {
+  return x < 0.0 ? 0.0 : (x > 1.0 ? 1.0 : x);
+}
+
+std::string_view to_string(RaceEvent e) {
+  switch (e) {
+    case RaceEvent::SC:  return "SC";
+    case RaceEvent::VSC: return "VSC";
+    default:             return "GREEN";
+  }
+}
+
+std::optional<RaceEvent> parse_race_event(std::string_view s) {
+  auto eq = [&](std::string_view k) {
+    return s.size() == k.size() &&
+           std::equal(s.begin(), s.end(), k.begin(), [](char a, char b) {
+             return std::toupper(static_cast<unsigned char>(a)) == b;
+           });
+  };
+  if (eq("SC"))                 return RaceEvent::SC;
+  if (eq("VSC"))                return RaceEvent::VSC;
+  if (s.empty() || eq("GREEN")) return RaceEvent::Green;
+  return std::nullopt;
+}
+
+EventMix EventMix::from(double p_sc, double p_vsc) {
+  EventMix m{clamp01(p_sc), clamp01(p_vsc)};
+  const double total = m.sc + m.vsc;
+  if (total > 1.0) {
+    m.sc  /= total;
+    m.vsc /= total;
+  }
+  return m;
+}
+
+void PackedEventStream::resize(std::size_t n) {
+  words_.resize((n + kPerWord - 1) / kPerWord, 0);
+  if (n < n_ && n % kPerWord != 0) {
+    words_.back() &= (std::uint64_t{1} << shift_(n)) - 1; // keep bits past size() zero
+  }
+  n_ = n;
+}
+
+std::size_t PackedEventStream::count(RaceEvent e) const {
+  constexpr std::uint64_t kLo = 0x5555555555555555ull;
+  std::size_t c = 0;
+  for (std::uint64_t w : words_) {
+    const std::uint64_t lo = w & kLo, hi = (w >> 1) & kLo;
+    switch (e) {
+      case RaceEvent::SC:  c += std::size_t(std::popcount(hi & ~lo)); break;
+      case RaceEvent::VSC: c += std::size_t(std::popcount(lo & ~hi)); break;
+      default:             c += std::size_t(std::popcount(~(hi | lo) & kLo)); break;
+    }
+  }
+  // Padding past size() decodes as Green
+  if (e == RaceEvent::Green) c -= words_.size() * kPerWord - n_;
+  return c;
+}
+
+bool lane_factors_from_stream(const Track& track, const PackedEventStream& s, std::span<double> out) {
+  if (out.size() < s.size()) return false;
+  const double lut[4]{1.0, track.vsc_lane_factor, track.sc_lane_factor, 1.0};
+  const auto words = s.words();
+  double* o = out.data();
+  for (std::size_t wi = 0; wi < words.size(); ++wi) {
+    std::uint64_t w = words[wi];
+    const std::size_t n = std::min(PackedEventStream::kPerWord, s.size() - wi * PackedEventStream::kPerWord);
+    for (std::size_t j = 0; j < n; ++j, w >>= 2) o[j] = lut[w & 3u];
+    o += n;
+  }
+  return true;
+}
+
+std::vector<double> lane_factors_from_stream(const Track& track, const PackedEventStream& s) {
+  std::vector<double> out(s.size());
+  lane_factors_from_stream(track, s, out);
+  return out;
+}
+
+} // namespace f1tm
@@ -0,0 +1,64 @@
+#include <f1tm/mapped_file.hpp>
+
+#if defined(_WIN32)
+  #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+  #endif
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace f1tm {
+
+bool MappedFile::open(const std::string& path) {
+  close();
+#if defined(_WIN32)
+  HANDLE f = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                         OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (f == INVALID_HANDLE_VALUE) return false;
+  LARGE_INTEGER sz{};
+  if (!GetFileSizeEx(f, &sz) || sz.QuadPart == 0) { CloseHandle(f); return false; }
+  HANDLE m = CreateFileMappingA(f, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!m) { CloseHandle(f); return false; }
+  void* p = MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0);
+  if (!p) { CloseHandle(m); CloseHandle(f); return false; }
+  file_ = f;
+  mapping_ = m;
+  data_ = static_cast<const std::uint8_t*>(p);
+  size_ = static_cast<std::size_t>(sz.QuadPart);
+#else
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+  struct stat st{};
+  if (::fstat(fd, &st) != 0 || st.st_size <= 0) { ::close(fd); return false; }
+  void* p = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd); // the mapping keeps the file referenced
+  if (p == MAP_FAILED) return false;
+  data_ = static_cast<const std::uint8_t*>(p);
+  size_ = static_cast<std::size_t>(st.st_size);
+#endif
+  return true;
+}
+
+void MappedFile::close() {
+  if (!data_) return;
+#if defined(_WIN32)
+  UnmapViewOfFile(data_);
+  CloseHandle(static_cast<HANDLE>(mapping_));
+  CloseHandle(static_cast<HANDLE>(file_));
+  file_ = mapping_ = nullptr;
+#else
+  ::munmap(const_cast<std::uint8_t*>(data_), size_);
+#endif
+  data_ = nullptr;
+  size_ = 0;
+}
+
+} // namespace f1tm
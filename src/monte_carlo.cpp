@@ -0,0 +1,318 @@
+#include <f1tm/monte_carlo.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <f1tm/counter_rng.hpp>
+#include <f1tm/event_stream.hpp>
+#include <f1tm/pit.hpp>
+#include <f1tm/stats.hpp>
+
+namespace f1tm {
+
+namespace {
+
+constexpr std::uint64_t kChunk = 8192; // scenarios per work item
+
+double clamp01(double x) { return x < 0.0 ? 0.0 : (x > 1.0 ? 1.0 : x); }
+
+struct Candidate {
+  double fixed = 0.0;   // stints + stationary time (event independent)
+  double lane = 0.0;    // lane loss per stop at factor 1
+  std::size_t stops = 0;
+
+  // Total minus fixed, given per-stop lane factors.
+  double variable(const double* factor) const {
+    double d = 0.0;
+    for (std::size_t k = 0; k < stops; ++k) d += lane * factor[k];
+    return d;
+  }
+};
+
+Candidate make_candidate(const StrategyCandidate& sc, const PitParams& pit) {
+  Candidate k;
+  k.stops = sc.stops;
+  k.fixed = sc.stint_time + double(k.stops) * std::max(0.0, pit.stationary);
+  k.lane = std::max(0.0, pit.lane);
+  return k;
+}
+
+// Scenario s -> lane factor at each stop.
+class ScenarioModel {
+public:
+  ScenarioModel(const Track& track, double p_sc, double p_vsc, SamplingMode mode, const CounterRng& rng)
+    : mix_(EventMix::from(p_sc, p_vsc)),
+      f_sc_(clamp01(track.sc_lane_factor)),
+      f_vsc_(clamp01(track.vsc_lane_factor)),
+      sampler_(mode, rng) {}
+
+  void factors(std::uint64_t s, std::size_t stops, double* out) const {
+    for (std::size_t k = 0; k < stops; ++k) {
+      const RaceEvent e = mix_.draw(sampler_.uniform(s, k));
+      out[k] = e == RaceEvent::SC ? f_sc_ : (e == RaceEvent::VSC ? f_vsc_ : 1.0);
+    }
+  }
+
+private:
+  EventMix mix_;
+  double f_sc_, f_vsc_;
+  ScenarioSampler sampler_;
+};
+
+struct ChunkSums {
+  std::vector<double> sum, sumsq; // of (total - fixed), per candidate
+};
+
+} // namespace
+
+std::optional<MonteCarloResult> simulate_strategy_outcomes(
+    const std::vector<std::vector<StintParams>>& candidates,
+    const Track& track,
+    const MonteCarloOptions& opt) {
+  const auto sc = strategy_candidates(candidates);
+  if (!sc) return std::nullopt;
+  return simulate_candidate_outcomes(*sc, track, opt);
+}
+
+std::optional<MonteCarloResult> simulate_candidate_outcomes(
+    const std::vector<StrategyCandidate>& candidates,
+    const Track& track,
+    const MonteCarloOptions& opt) {
+  if (candidates.empty() || opt.scenarios == 0) return std::nullopt;
+  for (double q : opt.quantiles) if (!(q >= 0.0 && q <= 1.0)) return std::nullopt;
+
+  const std::size_t n = candidates.size();
+  const PitParams pit = track_pit_params(track);
+  std::vector<Candidate> cand(n);
+  std::size_t max_stops = 0;
+  for (std::size_t c = 0; c < n; ++c) {
+    cand[c] = make_candidate(candidates[c], pit);
+    max_stops = std::max(max_stops, cand[c].stops);
+  }
+  const ScenarioModel model(track, opt.p_sc, opt.p_vsc, opt.sampling, CounterRng(opt.seed));
+
+  const std::uint64_t N = opt.scenarios;
+  const std::uint64_t chunks = (N + kChunk - 1) / kChunk;
+  std::vector<std::vector<double>> totals(n, std::vector<double>(N));
+  std::vector<ChunkSums> chunk_sums(chunks);
+
+  unsigned threads = opt.threads ? opt.threads : std::thread::hardware_concurrency();
+  threads = std::max(1u, std::min<unsigned>(threads, unsigned(chunks)));
+  std::vector<std::vector<std::uint64_t>> wins(threads, std::vector<std::uint64_t>(n, 0));
+  std::vector<std::vector<std::uint64_t>> beats(threads, std::vector<std::uint64_t>(n * n, 0));
+  std::atomic<std::uint64_t> next{0};
+
+  auto worker = [&](unsigned w) {
+    std::vector<double> factor(max_stops);
+    std::vector<double> t(n);
+    for (std::uint64_t ch; (ch = next.fetch_add(1, std::memory_order_relaxed)) < chunks; ) {
+      ChunkSums& cs = chunk_sums[ch];
+      cs.sum.assign(n, 0.0);
+      cs.sumsq.assign(n, 0.0);
+      const std::uint64_t s_end = std::min(N, (ch + 1) * kChunk);
+      for (std::uint64_t s = ch * kChunk; s < s_end; ++s) {
+        model.factors(s, max_stops, factor.data());
+        std::size_t best = 0;
+        for (std::size_t c = 0; c < n; ++c) {
+          const double d = cand[c].variable(factor.data());
+          cs.sum[c] += d;
+          cs.sumsq[c] += d * d;
+          t[c] = cand[c].fixed + d;
+          totals[c][s] = t[c];
+          if (t[c] < t[best]) best = c;
+        }
+        ++wins[w][best];
+        for (std::size_t i = 0; i < n; ++i) {
+          for (std::size_t j = 0; j < n; ++j) beats[w][i * n + j] += t[i] < t[j] ? 1u : 0u;
+        }
+      }
+    }
+  };
+  std::vector<std::thread> pool;
+  for (unsigned w = 1; w < threads; ++w) pool.emplace_back(worker, w);
+  worker(0);
+  for (auto& th : pool) th.join();
+
+  MonteCarloResult res;
+  res.scenarios = N;
+  res.outcomes.resize(n);
+  res.beats.assign(n * n, 0.0);
+  const double inv = 1.0 / double(N);
+  for (std::size_t c = 0; c < n; ++c) {
+    StrategyOutcome& o = res.outcomes[c];
+    double sum = 0.0, sumsq = 0.0;
+    for (const auto& cs : chunk_sums) { sum += cs.sum[c]; sumsq += cs.sumsq[c]; }
+    const double m = sum * inv; // mean of (total - fixed)
+    o.mean = cand[c].fixed + m;
+    o.stddev = std::sqrt(std::max(0.0, sumsq * inv - m * m));
+
+    std::uint64_t w = 0;
+    for (const auto& wt : wins) w += wt[c];
+    o.win_prob = double(w) * inv;
+    for (std::size_t j = 0; j < n; ++j) {
+      std::uint64_t b = 0;
+      for (const auto& bt : beats) b += bt[c * n + j];
+      res.beats[c * n + j] = double(b) * inv;
+    }
+
+    // Nearest-rank quantiles; selection only reorders this candidate's totals.
+    auto& v = totals[c];
+    const auto [lo, hi] = std::minmax_element(v.begin(), v.end());
+    o.min = *lo;
+    o.max = *hi;
+    o.quantiles.resize(opt.quantiles.size());
+    for (std::size_t q = 0; q < opt.quantiles.size(); ++q) {
+      const double r = std::ceil(opt.quantiles[q] * double(N));
+      const std::uint64_t idx = r < 1.0 ? 0 : std::min<std::uint64_t>(N - 1, std::uint64_t(r) - 1);
+      std::nth_element(v.begin(), v.begin() + std::ptrdiff_t(idx), v.end());
+      o.quantiles[q] = v[idx];
+    }
+  }
+  return res;
+}
+
+namespace {
+
+constexpr std::uint64_t kRiskScoreTag = 0x5249534B51544C45ull; // context tag: "RISKQTLE"
+
+} // namespace
+
+std::optional<std::vector<RankedStrategy>> rank_strategies_under_risk(
+    const std::vector<std::vector<StintParams>>& plans,
+    const Track& track,
+    const RiskRankOptions& opt,
+    EvaluationCache* cache) {
+  if (plans.empty() || opt.mc.scenarios == 0 || !(opt.quantile >= 0.0 && opt.quantile <= 1.0)) {
+    return std::nullopt;
+  }
+  for (const auto& p : plans) if (p.empty()) return std::nullopt;
+
+  // Everything the score depends on besides plan and track; threads do not matter.
+  const std::uint64_t context[] = {kRiskScoreTag, opt.mc.scenarios, opt.mc.seed,
+                                   StrategyKey::quantized(opt.mc.p_sc),
+                                   StrategyKey::quantized(opt.mc.p_vsc),
+                                   std::uint64_t(opt.mc.sampling),
+                                   StrategyKey::quantized(opt.quantile)};
+  const PackedEventStream sampled; // events are drawn, not given
+
+  std::vector<RankedStrategy> out(plans.size());
+  std::vector<StrategyKey> keys(cache ? plans.size() : 0);
+  std::vector<std::size_t> missed;
+  std::vector<StrategyCandidate> todo;
+  for (std::size_t i = 0; i < plans.size(); ++i) {
+    out[i].index = i;
+    if (cache) {
+      keys[i].assign(plans[i], track, sampled, context);
+      if (const auto v = cache->find(keys[i])) { out[i].score = *v; continue; }
+    }
+    missed.push_back(i);
+    todo.push_back(strategy_candidate(plans[i]));
+  }
+
+  if (!todo.empty()) {
+    MonteCarloOptions mc = opt.mc;
+    mc.quantiles = {opt.quantile};
+    const auto r = simulate_candidate_outcomes(todo, track, mc);
+    if (!r) return std::nullopt;
+    for (std::size_t k = 0; k < missed.size(); ++k) {
+      out[missed[k]].score = r->outcomes[k].quantiles[0];
+      if (cache) cache->insert(keys[missed[k]], out[missed[k]].score);
+    }
+  }
+  std::stable_sort(out.begin(), out.end(),
+                   [](const RankedStrategy& a, const RankedStrategy& b) { return a.score < b.score; });
+  return out;
+}
+
+namespace {
+
+// Two-sided 95% critical values: normal, and Student t with kReplicates - 1 dof.
+constexpr double kZ95 = 1.959964;
+constexpr std::size_t kReplicates = 16;
+constexpr double kT95_15 = 2.131450;
+
+} // namespace
+
+std::optional<PairedComparison> compare_strategies(const std::vector<StintParams>& a,
+                                                   const std::vector<StintParams>& b,
+                                                   const Track& track,
+                                                   const PairedComparisonOptions& opt) {
+  if (a.empty() || b.empty()) return std::nullopt;
+  return compare_candidates(strategy_candidate(a), strategy_candidate(b), track, opt);
+}
+
+std::optional<PairedComparison> compare_candidates(const StrategyCandidate& a,
+                                                  const StrategyCandidate& b,
+                                                  const Track& track,
+                                                  const PairedComparisonOptions& opt) {
+  if (opt.max_scenarios == 0 || !(opt.ci_half_width >= 0.0)) return std::nullopt;
+  const PitParams pit = track_pit_params(track);
+  const Candidate ca = make_candidate(a, pit);
+  const Candidate cb = make_candidate(b, pit);
+
+  const std::uint64_t min_n = std::min(opt.min_scenarios, opt.max_scenarios);
+  const std::size_t stops = std::max(ca.stops, cb.stops);
+  const double fixed_delta = ca.fixed - cb.fixed;
+  std::vector<double> factor(stops);
+  PairedComparison res{};
+  std::uint64_t a_faster = 0;
+
+  // Delta of scenario s under model m; also counts wins for a.
+  auto delta = [&](const ScenarioModel& m, std::uint64_t s) {
+    m.factors(s, stops, factor.data());
+    const double d = fixed_delta + (ca.variable(factor.data()) - cb.variable(factor.data()));
+    a_faster += d < 0.0 ? 1u : 0u;
+    return d;
+  };
+
+  if (opt.sampling == SamplingMode::Sobol) {
+    // Randomized QMC: independently shifted replicates, each extended over the
+    // Sobol points [m, 2m) per round; the error comes from the spread of their means.
+    const CounterRng root(opt.seed);
+    std::vector<ScenarioModel> reps;
+    for (std::size_t r = 0; r < kReplicates; ++r) {
+      reps.emplace_back(track, opt.p_sc, opt.p_vsc, SamplingMode::Sobol, root.split(r));
+    }
+    std::vector<double> sum(kReplicates, 0.0);
+    std::uint64_t m = 0;
+    std::uint64_t next = std::max<std::uint64_t>(1, min_n / kReplicates);
+    while (true) {
+      for (std::size_t r = 0; r < kReplicates; ++r) {
+        for (std::uint64_t s = m; s < next; ++s) sum[r] += delta(reps[r], s);
+      }
+      m = next;
+      RunningStats means;
+      for (double x : sum) means.add(x / double(m));
+      res.mean_delta = means.mean();
+      res.ci_half_width = kT95_15 * means.stddev() / std::sqrt(double(kReplicates));
+      res.scenarios = m * kReplicates;
+      if (res.ci_half_width <= opt.ci_half_width) { res.converged = true; break; }
+      if (2 * m * kReplicates > opt.max_scenarios) break;
+      next = 2 * m;
+    }
+  } else {
+    // Independent units: one scenario, or an antithetic pair averaged into one.
+    const ScenarioModel model(track, opt.p_sc, opt.p_vsc, opt.sampling, CounterRng(opt.seed));
+    const std::uint64_t per_unit = opt.sampling == SamplingMode::Antithetic ? 2 : 1;
+    RunningStats units;
+    std::uint64_t u = 0;
+    std::uint64_t next = std::max<std::uint64_t>(2, min_n / per_unit);
+    while (true) {
+      for (; u < next; ++u) {
+        double d = 0.0;
+        for (std::uint64_t j = 0; j < per_unit; ++j) d += delta(model, u * per_unit + j);
+        units.add(d / double(per_unit));
+      }
+      res.mean_delta = units.mean();
+      res.ci_half_width = kZ95 * units.stddev() / std::sqrt(double(units.count()));
+      res.scenarios = u * per_unit;
+      if (res.ci_half_width <= opt.ci_half_width) { res.converged = true; break; }
+      if (2 * u * per_unit > opt.max_scenarios) break;
+      next = 2 * u;
+    }
+  }
+  res.p_a_faster = double(a_faster) / double(res.scenarios);
+  return res;
+}
+
+} // namespace f1tm
@@ -0,0 +1,85 @@
+#include <f1tm/profiler.hpp>
+#include <algorithm>
+#include <bit>
+
+namespace f1tm {
+
+// ---- StageHistogram ----
+
+std::size_t StageHistogram::bucket_of(std::uint64_t ns) {
+  constexpr std::uint64_t kSub = 1u << kSubBits;
+  if (ns < kSub) return std::size_t(ns);
+  const int msb = std::min(int(std::bit_width(ns)) - 1, kMaxMsb);
+  if (msb == kMaxMsb && (ns >> kMaxMsb) > 1) return kBuckets - 1; // clamp
+  const int shift = msb - kSubBits;
+  const std::uint64_t sub = (ns >> shift) & (kSub - 1);
+  return std::size_t(shift + 1) * kSub + std::size_t(sub);
+}
+
+std::uint64_t StageHistogram::bucket_lower(std::size_t bucket) {
+  constexpr std::size_t kSub = std::size_t(1) << kSubBits;
+  if (bucket < kSub) return bucket;
+  const std::size_t octave = bucket / kSub;  // shift + 1
+  return std::uint64_t(kSub + bucket % kSub) << (octave - 1);
+}
+
+std::uint64_t StageHistogram::bucket_width(std::size_t bucket) {
+  constexpr std::size_t kSub = std::size_t(1) << kSubBits;
+  if (bucket < kSub) return 1;
+  return std::uint64_t(1) << (bucket / kSub - 1);
+}
+
+void StageHistogram::record(std::uint64_t ns) {
+  buckets_[bucket_of(ns)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  sum_ns_.fetch_add(ns, std::memory_order_relaxed);
+  std::uint64_t m = max_ns_.load(std::memory_order_relaxed);
+  while (ns > m && !max_ns_.compare_exchange_weak(m, ns, std::memory_order_relaxed)) {}
+}
+
+void StageHistogram::reset() {
+  for (auto& b : buckets_) b.store(0, std::memory_order_relaxed);
+  count_.store(0, std::memory_order_relaxed);
+  sum_ns_.store(0, std::memory_order_relaxed);
+  max_ns_.store(0, std::memory_order_relaxed);
+}
+
+double StageHistogram::mean_ns() const {
+  const std::uint64_t n = count();
+  return n ? double(total_ns()) / double(n) : 0.0;
+}
+
+double StageHistogram::quantile_ns(double q) const {
+  // Read the buckets once so the walk sees one total.
+  std::array<std::uint64_t, kBuckets> c;
+  std::uint64_t total = 0;
+  for (std::size_t i = 0; i < kBuckets; ++i) {
+    c[i] = buckets_[i].load(std::memory_order_relaxed);
+    total += c[i];
+  }
+  if (total == 0) return 0.0;
+  q = std::clamp(q, 0.0, 1.0);
+  // Rank of the sample, 1-based (nearest rank).
+  const auto rank = std::max<std::uint64_t>(1, std::uint64_t(q * double(total) + 0.999999));
+  std::uint64_t seen = 0;
+  std::size_t i = 0;
+  for (; i < kBuckets; ++i) {
+    seen += c[i];
+    if (seen >= rank) break;
+  }
+  i = std::min(i, kBuckets - 1);
+  const double mid = double(bucket_lower(i)) + 0.5 * double(bucket_width(i) - 1);
+  const auto mx = max_ns();
+  return (mx > 0) ? std::min(mid, double(mx)) : mid;
+}
+
+// ---- StageProfiler ----
+
+StageProfiler::StageProfiler(std::initializer_list<const char*> names)
+  : names_(names), hist_(std::make_unique<StageHistogram[]>(names.size())) {}
+
+void StageProfiler::reset() {
+  for (std::size_t i = 0; i < names_.size(); ++i) hist_[i].reset();
+}
+
+} // namespace f1tm
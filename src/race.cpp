@@ -1,5 +1,7 @@
 #include <f1tm/race.hpp>
 #include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace f1tm {
 
@@ -55,21 +57,16 @@ std::optional<double> race_time_with_pits_under(const std::vector<StintParams>&
   return sum;
 }
 
-static inline std::string upper(std::string s) {
-  for (auto& c : s) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
-  return s;
-}
-
 std::vector<double> lane_factors_from_events(const Track& track,
                                              const std::vector<std::string>& events) {
   std::vector<double> out;
   out.reserve(events.size());
-  for (auto e : events) {
-    const auto E = upper(e);
-    if (E == "SC")       out.push_back(track.sc_lane_factor);
-    else if (E == "VSC") out.push_back(track.vsc_lane_factor);
-    else if (E == "GREEN" || E.empty()) out.push_back(1.0);
-    else out.push_back(std::numeric_limits<double>::quiet_NaN()); // sentinel for unknown
+  for (const auto& e : events) {
+    const auto ev = parse_race_event(e);
+    if (!ev) out.push_back(std::numeric_limits<double>::quiet_NaN()); // sentinel for unknown
+    else if (*ev == RaceEvent::SC)  out.push_back(track.sc_lane_factor);
+    else if (*ev == RaceEvent::VSC) out.push_back(track.vsc_lane_factor);
+    else out.push_back(1.0);
   }
   return out;
 }
@@ -92,4 +89,21 @@ std::optional<double> race_time_with_track(const std::vector<StintParams>& stint
   return race_time_with_pits_under(stints, pits, lane_factors);
 }
 
+std::optional<double> race_time_with_track(const std::vector<StintParams>& stints,
+                                           const Track& track,
+                                           const PackedEventStream& events) {
+  if (stints.empty()) return std::nullopt;
+  if (events.size() + 1 != stints.size()) return std::nullopt;
+  // Same sum as race_time_with_pits_under, without building pits/factor vectors.
+  const double stat = std::max(0.0, track.pit_stationary_s);
+  const double lane = std::max(0.0, track.pit_lane_delta_s);
+  const double lut[4]{1.0, clamp01(track.vsc_lane_factor), clamp01(track.sc_lane_factor), 1.0};
+  double sum = 0.0;
+  for (size_t i = 0; i < stints.size(); ++i) {
+    sum += estimate_stint_time(stints[i]);
+    if (i < events.size()) sum += stat + lane * lut[std::size_t(events[i])];
+  }
+  return sum;
+}
+
 } // namespace f1tm
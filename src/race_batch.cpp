@@ -0,0 +1,100 @@
+#include <f1tm/race_batch.hpp>
+#include <algorithm>
+
+namespace f1tm {
+
+StrategyBatch::StrategyBatch(std::size_t stints)
+  : stint_cols_(std::max<std::size_t>(1, stints)),
+    stop_cols_(std::max<std::size_t>(1, stints) - 1) {}
+
+void StrategyBatch::reserve(std::size_t n) {
+  for (auto& c : stint_cols_) { c.laps.reserve(n); c.base.reserve(n); c.deg.reserve(n); }
+  for (auto& c : stop_cols_)  { c.stationary.reserve(n); c.lane.reserve(n); c.factor.reserve(n); }
+}
+
+void StrategyBatch::resize(std::size_t n) {
+  for (auto& c : stint_cols_) { c.laps.resize(n, 0); c.base.resize(n, 0.0); c.deg.resize(n, 0.0); }
+  for (auto& c : stop_cols_)  {
+    c.stationary.resize(n, 0.0); c.lane.resize(n, 0.0); c.factor.resize(n, 0.0);
+  }
+  n_ = n;
+}
+
+bool StrategyBatch::add(const std::vector<StintParams>& stints,
+                        const std::vector<PitParams>& pits,
+                        const std::vector<double>& lane_factors) {
+  if (stints.empty() || stints.size() > this->stints()) return false;
+  if (pits.size() + 1 != stints.size() || lane_factors.size() != pits.size()) return false;
+
+  const std::size_t i = n_;
+  resize(n_ + 1);
+  for (std::size_t k = 0; k < stints.size(); ++k) {
+    stint_cols_[k].laps[i] = stints[k].laps;
+    stint_cols_[k].base[i] = stints[k].baseLap;
+    stint_cols_[k].deg[i]  = stints[k].degradationPerLap;
+  }
+  for (std::size_t k = 0; k < pits.size(); ++k) {
+    stop_cols_[k].stationary[i] = pits[k].stationary;
+    stop_cols_[k].lane[i]       = pits[k].lane;
+    stop_cols_[k].factor[i]     = lane_factors[k];
+  }
+  return true;
+}
+
+namespace batch_detail {
+
+void add_stop_column(const double* stat, const double* lane, const double* factor,
+                     double* acc, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    const double f = std::clamp(factor[i], 0.0, 1.0);
+    acc[i] += std::max(0.0, stat[i]) + std::max(0.0, lane[i]) * f;
+  }
+}
+
+} // namespace batch_detail
+
+namespace {
+
+using batch_detail::kTile;
+using batch_detail::add_stop_column;
+
+// estimate_stint_time over a column slice, accumulated into acc.
+inline void add_stint_column(const int* laps, const double* base, const double* deg,
+                             double* acc, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    const double l = static_cast<double>(std::max(0, laps[i]));
+    const double t = l * base[i] + deg[i] * l * (l - 1.0) * 0.5;
+    const bool invalid = (base[i] <= 0.0) | (deg[i] < 0.0); // non-short-circuit: a select
+    acc[i] += invalid ? 0.0 : t;
+  }
+}
+
+} // namespace
+
+bool race_time_batch(const StrategyBatch& batch, std::size_t first, std::span<double> out) {
+  if (first > batch.size() || out.size() > batch.size() - first) return false;
+  double acc[kTile];
+  for (std::size_t t0 = 0; t0 < out.size(); t0 += kTile) {
+    const std::size_t n = std::min(kTile, out.size() - t0);
+    const std::size_t i0 = first + t0;
+    std::fill(acc, acc + n, 0.0);
+    // Column passes in scalar summation order: stint 0, stop 0, stint 1, ...
+    for (std::size_t k = 0; k < batch.stints(); ++k) {
+      add_stint_column(batch.laps(k).data() + i0, batch.base_lap(k).data() + i0,
+                       batch.deg_per_lap(k).data() + i0, acc, n);
+      if (k < batch.stops()) {
+        add_stop_column(batch.stationary(k).data() + i0, batch.lane(k).data() + i0,
+                        batch.lane_factor(k).data() + i0, acc, n);
+      }
+    }
+    std::copy(acc, acc + n, out.data() + t0);
+  }
+  return true;
+}
+
+bool race_time_batch(const StrategyBatch& batch, std::span<double> out) {
+  if (out.size() < batch.size()) return false;
+  return race_time_batch(batch, 0, out.first(batch.size()));
+}
+
+} // namespace f1tm
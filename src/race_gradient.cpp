@@ -0,0 +1,158 @@
+#include <f1tm/race_gradient.hpp>
+#include <algorithm>
+#include <cmath>
+#include <f1tm/race.hpp>
+
+namespace f1tm {
+
+static inline bool stint_valid(const StintParams& s) {
+  return s.baseLap > 0.0 && s.degradationPerLap >= 0.0;
+}
+
+double stint_time_continuous(double laps, double base, double deg) {
+  if (!(laps > 0.0) || base <= 0.0 || deg < 0.0) return 0.0;
+  return laps * base + deg * laps * (laps - 1.0) * 0.5;
+}
+
+std::optional<RaceTimeGradient> race_time_gradient(const std::vector<StintParams>& stints,
+                                                   const std::vector<PitParams>& pits,
+                                                   const std::vector<double>& lane_factors) {
+  const auto total = race_time_with_pits_under(stints, pits, lane_factors);
+  if (!total) return std::nullopt;
+
+  RaceTimeGradient g;
+  g.total = *total;
+  g.stints.resize(stints.size());
+  for (std::size_t i = 0; i < stints.size(); ++i) {
+    const StintParams& s = stints[i];
+    if (!stint_valid(s) || s.laps <= 0) continue;
+    const double n = double(s.laps);
+    g.stints[i] = StintGradient{s.baseLap + s.degradationPerLap * (n - 0.5), n, n * (n - 1.0) * 0.5};
+  }
+  g.stops.resize(pits.size());
+  for (std::size_t k = 0; k < pits.size(); ++k) {
+    const double f = lane_factors[k];
+    const double fc = std::clamp(f, 0.0, 1.0);
+    g.stops[k] = StopGradient{
+      pits[k].stationary >= 0.0 ? 1.0 : 0.0,
+      pits[k].lane >= 0.0 ? fc : 0.0,
+      (f > 0.0 && f < 1.0) ? std::max(0.0, pits[k].lane) : 0.0,
+    };
+  }
+  return g;
+}
+
+std::optional<LapSplitResult> optimize_lap_split(int race_laps,
+                                                 const std::vector<StintParams>& stints,
+                                                 const std::vector<PitParams>& pits,
+                                                 const std::vector<double>& lane_factors,
+                                                 const LapSplitOptions& opt) {
+  const std::size_t S = stints.size();
+  if (S == 0 || pits.size() + 1 != S || lane_factors.size() != pits.size()) return std::nullopt;
+  if (!opt.max_stint_laps.empty() && opt.max_stint_laps.size() != S) return std::nullopt;
+  for (const auto& s : stints) if (!stint_valid(s)) return std::nullopt;
+
+  std::vector<int> lo(S, std::max(0, opt.min_stint_laps)), hi(S, race_laps);
+  long long sum_lo = 0, sum_hi = 0;
+  for (std::size_t i = 0; i < S; ++i) {
+    if (!opt.max_stint_laps.empty() && opt.max_stint_laps[i] > 0) hi[i] = std::min(hi[i], opt.max_stint_laps[i]);
+    if (hi[i] < lo[i]) return std::nullopt;
+    sum_lo += lo[i];
+    sum_hi += hi[i];
+  }
+  if (race_laps < sum_lo || race_laps > sum_hi) return std::nullopt;
+
+  LapSplitResult res;
+
+  // Relaxation: minimize sum c_i(n_i), c_i'(n) = b_i + d_i (n - 1/2), sum n_i = N, lo <= n <= hi.
+  // Stationarity gives n_i(lambda) = (lambda - b_i) / d_i + 1/2 on the free set; a
+  // degradation-free stint gets a tiny curvature so the system stays well posed.
+  std::vector<double> n(S);
+  std::vector<int> fixed(S, 0); // -1 at lo, +1 at hi
+  for (;;) {
+    ++res.newton_steps;
+    double rem = double(race_laps), inv_d = 0.0, off = 0.0;
+    for (std::size_t i = 0; i < S; ++i) {
+      if (fixed[i]) { rem -= n[i]; continue; }
+      const double d = std::max(stints[i].degradationPerLap, 1e-9);
+      inv_d += 1.0 / d;
+      off += 0.5 - stints[i].baseLap / d;
+    }
+    if (inv_d == 0.0) break; // everything at a bound; feasibility checked above
+    const double lambda = (rem - off) / inv_d;
+    double v_lo = 0.0, v_hi = 0.0;
+    for (std::size_t i = 0; i < S; ++i) {
+      if (fixed[i]) continue;
+      const double d = std::max(stints[i].degradationPerLap, 1e-9);
+      n[i] = (lambda - stints[i].baseLap) / d + 0.5;
+      if (n[i] < lo[i]) v_lo += lo[i] - n[i];
+      if (n[i] > hi[i]) v_hi += n[i] - hi[i];
+    }
+    if (v_lo == 0.0 && v_hi == 0.0) break;
+    // Fix the side with the larger total violation (Bitran-Hax); at most S steps.
+    for (std::size_t i = 0; i < S; ++i) {
+      if (fixed[i]) continue;
+      if (v_lo >= v_hi && n[i] < lo[i]) { n[i] = lo[i]; fixed[i] = -1; }
+      if (v_lo <  v_hi && n[i] > hi[i]) { n[i] = hi[i]; fixed[i] = +1; }
+    }
+  }
+  res.continuous_laps = n;
+
+  // Integer phase on the exact model.
+  auto cost = [&](std::size_t i, int l) {
+    ++res.evaluations;
+    return estimate_stint_time(StintParams{l, stints[i].baseLap, stints[i].degradationPerLap});
+  };
+  auto add_cost = [&](std::size_t i, int l) { return cost(i, l + 1) - cost(i, l); };
+  std::vector<int> laps(S);
+  int assigned = 0;
+  for (std::size_t i = 0; i < S; ++i) {
+    laps[i] = std::clamp(int(std::floor(n[i] + 1e-9)), lo[i], hi[i]);
+    assigned += laps[i];
+  }
+  for (; assigned < race_laps; ++assigned) {
+    std::size_t best = S;
+    double best_c = 0.0;
+    for (std::size_t i = 0; i < S; ++i) {
+      if (laps[i] >= hi[i]) continue;
+      const double c = add_cost(i, laps[i]);
+      if (best == S || c < best_c) { best = i; best_c = c; }
+    }
+    ++laps[best];
+  }
+  for (; assigned > race_laps; --assigned) { // the rounding tolerance can overshoot
+    std::size_t best = S;
+    double best_c = 0.0;
+    for (std::size_t i = 0; i < S; ++i) {
+      if (laps[i] <= lo[i]) continue;
+      const double c = add_cost(i, laps[i] - 1);
+      if (best == S || c > best_c) { best = i; best_c = c; }
+    }
+    --laps[best];
+  }
+  for (;;) { // single-lap transfers from the costliest last lap to the cheapest next lap
+    std::size_t from = S, to = S;
+    double save = 0.0, add = 0.0;
+    for (std::size_t i = 0; i < S; ++i) {
+      if (laps[i] > lo[i]) {
+        const double c = add_cost(i, laps[i] - 1);
+        if (from == S || c > save) { from = i; save = c; }
+      }
+      if (laps[i] < hi[i]) {
+        const double c = add_cost(i, laps[i]);
+        if (to == S || c < add) { to = i; add = c; }
+      }
+    }
+    if (from == S || to == S || from == to || !(add < save - 1e-12)) break;
+    --laps[from];
+    ++laps[to];
+  }
+
+  std::vector<StintParams> out = stints;
+  for (std::size_t i = 0; i < S; ++i) out[i].laps = laps[i];
+  res.laps = std::move(laps);
+  res.total_time = *race_time_with_pits_under(out, pits, lane_factors);
+  return res;
+}
+
+} // namespace f1tm
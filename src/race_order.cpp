@@ -0,0 +1,175 @@
+#include <f1tm/race_order.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace f1tm {
+
+namespace {
+
+constexpr std::int64_t kNotShown = -2; // differs from every real value, including -1
+
+// Writes v in decimal, zero-padded to `width` digits.
+char* put_uint(char* p, std::uint64_t v, int width = 1) {
+  char tmp[24];
+  int n = 0;
+  do { tmp[n++] = char('0' + v % 10); v /= 10; } while (v != 0);
+  while (n < width) tmp[n++] = '0';
+  while (n > 0) *p++ = tmp[--n];
+  return p;
+}
+
+// Copies [buf, end) to out with snprintf truncation semantics.
+int emit(const char* buf, const char* end, char* out, int cap) {
+  if (cap <= 0 || out == nullptr) return 0;
+  const int n = std::min(int(end - buf), cap - 1);
+  std::memcpy(out, buf, std::size_t(n));
+  out[n] = '\0';
+  return n;
+}
+
+int format_time_ms(std::int64_t ms, char* out, int cap) {
+  char buf[40];
+  char* p = buf;
+  if (ms < 0) {
+    *p++ = '-'; *p++ = '-';
+  } else {
+    const std::uint64_t u = std::uint64_t(ms);
+    const std::uint64_t minutes = u / 60000;
+    if (minutes > 0) {
+      p = put_uint(p, minutes);
+      *p++ = ':';
+      p = put_uint(p, (u / 1000) % 60, 2);
+    } else {
+      p = put_uint(p, u / 1000);
+    }
+    *p++ = '.';
+    p = put_uint(p, u % 1000, 3);
+  }
+  return emit(buf, p, out, cap);
+}
+
+int format_gap_ms(std::int64_t ms, char* out, int cap) {
+  char buf[40];
+  char* p = buf;
+  if (ms < 0) {
+    *p++ = '-'; *p++ = '-';
+  } else {
+    *p++ = '+';
+    p = put_uint(p, std::uint64_t(ms) / 1000);
+    *p++ = '.';
+    p = put_uint(p, std::uint64_t(ms) % 1000, 3);
+  }
+  return emit(buf, p, out, cap);
+}
+
+// Running order: more laps first, then further along the lap.
+bool ahead(const CarPose& a, const CarPose& b) {
+  if (a.lap != b.lap) return a.lap > b.lap;
+  return a.s > b.s;
+}
+
+} // namespace
+
+std::int64_t race_time_ms(double s) {
+  if (!(s >= 0.0 && s < 1e12)) return -1; // also rejects NaN
+  return static_cast<std::int64_t>(s * 1000.0 + 0.5);
+}
+
+int format_race_time(double s, char* out, int cap) { return format_time_ms(race_time_ms(s), out, cap); }
+int format_race_gap(double s, char* out, int cap) { return format_gap_ms(race_time_ms(s), out, cap); }
+
+void RaceOrder::clear() {
+  rows_.clear();
+  shown_.clear();
+  order_.clear();
+  std::fill(std::begin(sector_min_), std::end(sector_min_), -1.0);
+}
+
+void RaceOrder::update(std::span<const CarPose> cars) {
+  bool same = cars.size() == rows_.size();
+  for (std::size_t i = 0; same && i < cars.size(); ++i) same = rows_[i].pose.id == cars[i].id;
+
+  if (!same) {
+    // Car set changed (first frame, reseed): start over in snapshot order.
+    const std::size_t n = cars.size();
+    rows_.assign(n, RaceOrderRow{});
+    shown_.assign(n, Shown{kNotShown, kNotShown, kNotShown, kNotShown, kNotShown, kNotShown,
+                           kNotShown, 0});
+    order_.resize(n);
+    for (std::uint32_t i = 0; i < n; ++i) {
+      order_[i] = i;
+      char* end = put_uint(rows_[i].id, cars[i].id);
+      *end = '\0';
+      ++formatted_;
+    }
+  }
+
+  for (std::size_t i = 0; i < cars.size(); ++i) rows_[i].pose = cars[i];
+
+  // Insertion sort from last frame's order: O(n) plus one step per overtake.
+  for (std::size_t i = 1; i < order_.size(); ++i) {
+    const std::uint32_t cur = order_[i];
+    std::size_t j = i;
+    while (j > 0 && ahead(rows_[cur].pose, rows_[order_[j-1]].pose)) {
+      order_[j] = order_[j-1];
+      --j;
+    }
+    order_[j] = cur;
+  }
+
+  std::fill(std::begin(sector_min_), std::end(sector_min_), -1.0);
+  auto upd_min = [](double last, double& acc) {
+    if (last >= 0.0) acc = (acc < 0.0) ? last : std::min(acc, last);
+  };
+  for (const auto& r : rows_) {
+    upd_min(r.pose.s1_last, sector_min_[0]);
+    upd_min(r.pose.s2_last, sector_min_[1]);
+    upd_min(r.pose.s3_last, sector_min_[2]);
+  }
+
+  for (std::uint32_t pos = 0; pos < order_.size(); ++pos) refresh_text_(order_[pos], pos + 1);
+}
+
+void RaceOrder::refresh_text_(std::uint32_t slot, std::uint32_t pos) {
+  RaceOrderRow& r = rows_[slot];
+  Shown& sh = shown_[slot];
+  const CarPose& c = r.pose;
+
+  if (sh.pos != pos) {
+    sh.pos = pos;
+    char* p = r.pos;
+    if (pos < 10) *p++ = ' '; // "%2d"
+    *put_uint(p, pos) = '\0';
+    ++formatted_;
+  }
+  const auto lap = static_cast<std::int64_t>(c.lap);
+  if (sh.lap != lap) {
+    sh.lap = lap;
+    *put_uint(r.lap, c.lap) = '\0';
+    ++formatted_;
+  }
+  auto cell = [&](double v, std::int64_t& shown, char* out, int cap, bool gap) {
+    const std::int64_t ms = race_time_ms(v);
+    if (ms == shown) return;
+    shown = ms;
+    if (gap) format_gap_ms(ms, out, cap);
+    else     format_time_ms(ms, out, cap);
+    ++formatted_;
+  };
+  cell(c.gap_to_leader_s, sh.gap,  r.gap,  sizeof(r.gap),  true);
+  cell(c.last_lap_time,   sh.last, r.last, sizeof(r.last), false);
+  cell(c.best_lap_time,   sh.best, r.best, sizeof(r.best), false);
+  cell(c.s1_last,         sh.s1,   r.s1,   sizeof(r.s1),   false);
+  cell(c.s2_last,         sh.s2,   r.s2,   sizeof(r.s2),   false);
+  cell(c.s3_last,         sh.s3,   r.s3,   sizeof(r.s3),   false);
+}
+
+std::vector<CarPose> RaceOrder::poses() const {
+  std::vector<CarPose> out;
+  out.reserve(order_.size());
+  for (std::uint32_t slot : order_) out.push_back(rows_[slot].pose);
+  return out;
+}
+
+} // namespace f1tm
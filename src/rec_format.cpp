@@ -0,0 +1,198 @@
+#include <f1tm/rec_format.hpp>
+#include <cmath>
+#include <unordered_map>
+
+namespace f1tm {
+
+namespace {
+
+std::int64_t quantize(double v, double scale) {
+  return static_cast<std::int64_t>(std::llround(v * scale));
+}
+
+std::uint64_t zigzag(std::int64_t v) {
+  return (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63);
+}
+std::int64_t unzigzag(std::uint64_t v) {
+  return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1);
+}
+
+void put_varint(std::vector<std::uint8_t>& out, std::uint64_t v) {
+  while (v >= 0x80) {
+    out.push_back(static_cast<std::uint8_t>(v | 0x80));
+    v >>= 7;
+  }
+  out.push_back(static_cast<std::uint8_t>(v));
+}
+
+bool get_varint(const std::uint8_t*& p, const std::uint8_t* end, std::uint64_t& v) {
+  v = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (p == end) return false;
+    const std::uint8_t b = *p++;
+    v |= static_cast<std::uint64_t>(b & 0x7F) << shift;
+    if ((b & 0x80) == 0) return true;
+  }
+  return false;
+}
+
+// Column = varint byte length + zigzag varint values.
+void put_column(std::vector<std::uint8_t>& out, const std::vector<std::int64_t>& deltas,
+                std::vector<std::uint8_t>& scratch) {
+  scratch.clear();
+  for (std::int64_t d : deltas) put_varint(scratch, zigzag(d));
+  put_varint(out, scratch.size());
+  out.insert(out.end(), scratch.begin(), scratch.end());
+}
+
+bool get_column(const std::uint8_t*& p, const std::uint8_t* end, std::uint32_t rows,
+                std::vector<std::int64_t>& deltas) {
+  std::uint64_t len = 0;
+  if (!get_varint(p, end, len) || len > static_cast<std::uint64_t>(end - p)) return false;
+  const std::uint8_t* col_end = p + len;
+  deltas.resize(rows);
+  for (std::uint32_t i = 0; i < rows; ++i) {
+    std::uint64_t z = 0;
+    if (!get_varint(p, col_end, z)) return false;
+    deltas[i] = unzigzag(z);
+  }
+  return p == col_end;
+}
+
+// Dense slot per distinct car id, in order of first appearance.
+template <class Row>
+std::vector<std::uint32_t> slots_by_id(const Row* rows, std::size_t n, std::size_t& nslots) {
+  std::unordered_map<CarId, std::uint32_t> slot;
+  std::vector<std::uint32_t> out(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    auto it = slot.try_emplace(rows[i].id, static_cast<std::uint32_t>(slot.size())).first;
+    out[i] = it->second;
+  }
+  nslots = slot.size();
+  return out;
+}
+
+// Deltas against the previous row.
+template <class Get>
+std::vector<std::int64_t> row_deltas(std::size_t n, Get get) {
+  std::vector<std::int64_t> d(n);
+  std::int64_t prev = 0;
+  for (std::size_t i = 0; i < n; ++i) { const std::int64_t v = get(i); d[i] = v - prev; prev = v; }
+  return d;
+}
+
+// Deltas against the same slot's previous row.
+template <class Get>
+std::vector<std::int64_t> slot_deltas(std::size_t n, const std::vector<std::uint32_t>& slot,
+                                      std::size_t nslots, Get get) {
+  std::vector<std::int64_t> d(n);
+  std::vector<std::int64_t> prev(nslots, 0);
+  for (std::size_t i = 0; i < n; ++i) {
+    const std::int64_t v = get(i);
+    d[i] = v - prev[slot[i]];
+    prev[slot[i]] = v;
+  }
+  return d;
+}
+
+template <class Set>
+void undo_row_deltas(const std::vector<std::int64_t>& d, Set set) {
+  std::int64_t v = 0;
+  for (std::size_t i = 0; i < d.size(); ++i) { v += d[i]; set(i, v); }
+}
+
+template <class Set>
+void undo_slot_deltas(const std::vector<std::int64_t>& d, const std::vector<std::uint32_t>& slot,
+                      std::size_t nslots, Set set) {
+  std::vector<std::int64_t> prev(nslots, 0);
+  for (std::size_t i = 0; i < d.size(); ++i) {
+    prev[slot[i]] += d[i];
+    set(i, prev[slot[i]]);
+  }
+}
+
+} // namespace
+
+void rec_encode_frames(const RecordRow* r, std::size_t n, std::vector<std::uint8_t>& out) {
+  out.clear();
+  std::vector<std::uint8_t> scratch;
+  std::size_t nslots = 0;
+  const auto slot = slots_by_id(r, n, nslots);
+
+  put_column(out, row_deltas(n, [&](std::size_t i){ return quantize(r[i].t, kRecTimeScale); }), scratch);
+  put_column(out, row_deltas(n, [&](std::size_t i){ return std::int64_t(r[i].tick); }), scratch);
+  put_column(out, row_deltas(n, [&](std::size_t i){ return std::int64_t(r[i].id); }), scratch);
+  put_column(out, slot_deltas(n, slot, nslots,
+      [&](std::size_t i){ return std::int64_t(r[i].lap); }), scratch);
+  put_column(out, slot_deltas(n, slot, nslots,
+      [&](std::size_t i){ return quantize(r[i].s, kRecMeterScale); }), scratch);
+  put_column(out, slot_deltas(n, slot, nslots,
+      [&](std::size_t i){ return quantize(r[i].x, kRecMeterScale); }), scratch);
+  put_column(out, slot_deltas(n, slot, nslots,
+      [&](std::size_t i){ return quantize(r[i].y, kRecMeterScale); }), scratch);
+  put_column(out, slot_deltas(n, slot, nslots,
+      [&](std::size_t i){ return quantize(r[i].heading_rad, kRecHeadingScale); }), scratch);
+  put_column(out, slot_deltas(n, slot, nslots,
+      [&](std::size_t i){ return quantize(r[i].speed_mps, kRecMeterScale); }), scratch);
+}
+
+bool rec_decode_frames(const std::uint8_t* p, std::size_t bytes, std::uint32_t rows,
+                       std::vector<RecordRow>& out) {
+  const std::uint8_t* end = p + bytes;
+  out.resize(rows);
+  std::vector<std::int64_t> d;
+  RecordRow* r = out.data();
+
+  if (!get_column(p, end, rows, d)) return false;
+  undo_row_deltas(d, [&](std::size_t i, std::int64_t v){ r[i].t = double(v) / kRecTimeScale; });
+  if (!get_column(p, end, rows, d)) return false;
+  undo_row_deltas(d, [&](std::size_t i, std::int64_t v){ r[i].tick = std::uint64_t(v); });
+  if (!get_column(p, end, rows, d)) return false;
+  undo_row_deltas(d, [&](std::size_t i, std::int64_t v){ r[i].id = CarId(v); });
+
+  std::size_t nslots = 0;
+  const auto slot = slots_by_id(r, rows, nslots);
+  if (!get_column(p, end, rows, d)) return false;
+  undo_slot_deltas(d, slot, nslots, [&](std::size_t i, std::int64_t v){ r[i].lap = std::uint32_t(v); });
+  if (!get_column(p, end, rows, d)) return false;
+  undo_slot_deltas(d, slot, nslots, [&](std::size_t i, std::int64_t v){ r[i].s = double(v) / kRecMeterScale; });
+  if (!get_column(p, end, rows, d)) return false;
+  undo_slot_deltas(d, slot, nslots, [&](std::size_t i, std::int64_t v){ r[i].x = double(v) / kRecMeterScale; });
+  if (!get_column(p, end, rows, d)) return false;
+  undo_slot_deltas(d, slot, nslots, [&](std::size_t i, std::int64_t v){ r[i].y = double(v) / kRecMeterScale; });
+  if (!get_column(p, end, rows, d)) return false;
+  undo_slot_deltas(d, slot, nslots,
+      [&](std::size_t i, std::int64_t v){ r[i].heading_rad = double(v) / kRecHeadingScale; });
+  if (!get_column(p, end, rows, d)) return false;
+  undo_slot_deltas(d, slot, nslots,
+      [&](std::size_t i, std::int64_t v){ r[i].speed_mps = double(v) / kRecMeterScale; });
+  return p == end;
+}
+
+void rec_encode_events(const RecordEvent* e, std::size_t n, std::vector<std::uint8_t>& out) {
+  out.clear();
+  std::vector<std::uint8_t> scratch;
+  put_column(out, row_deltas(n, [&](std::size_t i){ return quantize(e[i].t, kRecTimeScale); }), scratch);
+  put_column(out, row_deltas(n, [&](std::size_t i){ return std::int64_t(e[i].id); }), scratch);
+  put_column(out, row_deltas(n, [&](std::size_t i){ return std::int64_t(e[i].kind); }), scratch);
+  put_column(out, row_deltas(n, [&](std::size_t i){ return quantize(e[i].value, kRecTimeScale); }), scratch);
+}
+
+bool rec_decode_events(const std::uint8_t* p, std::size_t bytes, std::uint32_t rows,
+                       std::vector<RecordEvent>& out) {
+  const std::uint8_t* end = p + bytes;
+  out.resize(rows);
+  std::vector<std::int64_t> d;
+  RecordEvent* e = out.data();
+  if (!get_column(p, end, rows, d)) return false;
+  undo_row_deltas(d, [&](std::size_t i, std::int64_t v){ e[i].t = double(v) / kRecTimeScale; });
+  if (!get_column(p, end, rows, d)) return false;
+  undo_row_deltas(d, [&](std::size_t i, std::int64_t v){ e[i].id = CarId(v); });
+  if (!get_column(p, end, rows, d)) return false;
+  undo_row_deltas(d, [&](std::size_t i, std::int64_t v){ e[i].kind = RecordEventKind(v); });
+  if (!get_column(p, end, rows, d)) return false;
+  undo_row_deltas(d, [&](std::size_t i, std::int64_t v){ e[i].value = double(v) / kRecTimeScale; });
+  return p == end;
+}
+
+} // namespace f1tm
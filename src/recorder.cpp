@@ -0,0 +1,170 @@
+#include <f1tm/recorder.hpp>
+#include <chrono>
+#include <cstring>
+
+namespace f1tm {
+
+Recorder::Recorder(RecorderConfig cfg)
+  : cfg_(cfg), rows_(cfg.ring_rows), events_(cfg.ring_events) {
+  if (cfg_.block_rows == 0) cfg_.block_rows = 1;
+}
+
+bool Recorder::start(const std::string& path, std::uint32_t track_id) {
+  if (running_.load()) return false;
+  if (writing()) return false; // previous session still draining
+  join();                      // finished writer: returns at once
+  // Leftovers from a previous session (producer and consumer are both idle here).
+  RecordRow r; RecordEvent e;
+  while (rows_.try_pop(r)) {}
+  while (events_.try_pop(e)) {}
+
+  path_ = path;
+  pending_rows_.clear();
+  pending_events_.clear();
+  pending_rows_.reserve(cfg_.block_rows + 64);
+  stats_.bytes_written.store(0, std::memory_order_relaxed);
+  stop_.store(false);
+  writer_done_.store(false);
+  running_.store(true);
+  th_ = std::thread(&Recorder::writer_main_, this, track_id);
+  return true;
+}
+
+void Recorder::stop() {
+  if (!running_.load()) return;
+  running_.store(false);
+  stop_.store(true, std::memory_order_release);
+}
+
+void Recorder::join() {
+  if (th_.joinable()) th_.join();
+}
+
+bool Recorder::record(const SimSnapshot& snap) {
+  if (!running_.load(std::memory_order_relaxed)) return false;
+  if (rows_.write_available() < snap.cars.size()) {
+    stats_.frames_dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  for (const auto& c : snap.cars) {
+    RecordRow r;
+    r.t = snap.sim_time;
+    r.tick = snap.tick;
+    r.id = c.id;
+    r.lap = static_cast<std::uint32_t>(c.lap);
+    r.s = c.s;
+    r.x = c.x;
+    r.y = c.y;
+    r.heading_rad = c.heading_rad;
+    r.speed_mps = c.speed_mps;
+    rows_.try_push(r);
+  }
+  return true;
+}
+
+bool Recorder::record_event(const RecordEvent& ev) {
+  if (!running_.load(std::memory_order_relaxed)) return false;
+  if (!events_.try_push(ev)) {
+    stats_.events_dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+void Recorder::writer_main_(std::uint32_t track_id) {
+  out_.open(path_, std::ios::binary | std::ios::trunc);
+  if (!out_) {
+    stats_.open_failures.fetch_add(1, std::memory_order_relaxed);
+    running_.store(false);     // the producer stops recording; leftovers go at next start()
+    writer_done_.store(true, std::memory_order_release);
+    return;
+  }
+  RecFileHeader hdr{};
+  std::memcpy(hdr.magic, kRecMagic, sizeof(hdr.magic));
+  hdr.version = kRecVersion;
+  hdr.track_id = track_id;
+  out_.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+  stats_.bytes_written.fetch_add(sizeof(hdr), std::memory_order_relaxed);
+
+  while (!stop_.load(std::memory_order_acquire)) {
+    if (rows_.read_available() == 0 && events_.read_available() == 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      continue;
+    }
+    drain_();
+  }
+  drain_();
+  flush_frames_();
+  flush_events_();
+  out_.flush();
+  out_.close();
+  writer_done_.store(true, std::memory_order_release);
+}
+
+void Recorder::drain_() {
+  RecordRow r;
+  while (rows_.try_pop(r)) {
+    // Blocks end on tick boundaries so a reader never sees a partial tick.
+    if (pending_rows_.size() >= cfg_.block_rows && r.tick != pending_rows_.back().tick) {
+      flush_frames_();
+    }
+    pending_rows_.push_back(r);
+  }
+  RecordEvent e;
+  while (events_.try_pop(e)) {
+    pending_events_.push_back(e);
+    if (pending_events_.size() >= cfg_.block_rows) flush_events_();
+  }
+}
+
+void Recorder::flush_frames_() {
+  if (pending_rows_.empty()) return;
+  rec_encode_frames(pending_rows_.data(), pending_rows_.size(), payload_);
+  write_block_(RecBlockKind::Frames, static_cast<std::uint32_t>(pending_rows_.size()),
+               pending_rows_.front().t, pending_rows_.back().t);
+  stats_.rows_written.fetch_add(pending_rows_.size(), std::memory_order_relaxed);
+  pending_rows_.clear();
+}
+
+void Recorder::flush_events_() {
+  if (pending_events_.empty()) return;
+  rec_encode_events(pending_events_.data(), pending_events_.size(), payload_);
+  write_block_(RecBlockKind::Events, static_cast<std::uint32_t>(pending_events_.size()),
+               pending_events_.front().t, pending_events_.back().t);
+  stats_.events_written.fetch_add(pending_events_.size(), std::memory_order_relaxed);
+  pending_events_.clear();
+}
+
+void Recorder::write_block_(RecBlockKind kind, std::uint32_t rows, double t0, double t1) {
+  RecBlockHeader bh{};
+  bh.magic = kRecBlockMagic;
+  bh.kind = static_cast<std::uint32_t>(kind);
+  bh.rows = rows;
+  bh.bytes = static_cast<std::uint32_t>(payload_.size());
+  bh.t_first = t0;
+  bh.t_last = t1;
+  out_.write(reinterpret_cast<const char*>(&bh), sizeof(bh));
+  out_.write(reinterpret_cast<const char*>(payload_.data()),
+             static_cast<std::streamsize>(payload_.size()));
+  stats_.blocks_written.fetch_add(1, std::memory_order_relaxed);
+  stats_.bytes_written.fetch_add(sizeof(bh) + payload_.size(), std::memory_order_relaxed);
+}
+
+std::size_t record_lap_events(Recorder& rec, const SimServer& sim, const TelemetrySink& telem,
+                              std::vector<std::uint64_t>& lap_seen, double now_time) {
+  std::size_t n = 0;
+  lap_seen.resize(sim.car_count(), 0);
+  for (std::size_t i = 0; i < sim.car_count(); ++i) {
+    const auto* car = sim.car_by_index(i);
+    if (!car || car->laps <= lap_seen[i]) continue;
+    lap_seen[i] = car->laps;
+    TelemetryTimes tt{};
+    if (!telem.get_index(i, tt) || tt.last_lap < 0.0) continue; // untimed first crossing
+    // Stamp with the interpolated crossing, matching the recorded lap time.
+    const double at = tt.lap_line_time >= 0.0 ? tt.lap_line_time : now_time;
+    if (rec.record_event(RecordEvent{at, car->id, RecordEventKind::LapCompleted, tt.last_lap})) ++n;
+  }
+  return n;
+}
+
+} // namespace f1tm
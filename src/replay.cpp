@@ -0,0 +1,141 @@
+#include <f1tm/replay.hpp>
+#include <algorithm>
+#include <cstring>
+
+namespace f1tm {
+
+// ---- ReplayLog ----
+
+bool ReplayLog::open(const std::string& path) {
+  blocks_.clear();
+  events_.clear();
+  cached_ = static_cast<std::size_t>(-1);
+  if (!file_.open(path)) return false;
+
+  const std::uint8_t* d = file_.data();
+  const std::size_t n = file_.size();
+  RecFileHeader hdr{};
+  if (n < sizeof(hdr)) return false;
+  std::memcpy(&hdr, d, sizeof(hdr));
+  if (std::memcmp(hdr.magic, kRecMagic, sizeof(hdr.magic)) != 0 || hdr.version != kRecVersion) {
+    return false;
+  }
+  track_id_ = hdr.track_id;
+
+  // Index from block headers; only event payloads are decoded up front.
+  std::size_t off = sizeof(hdr);
+  std::vector<RecordEvent> ev;
+  while (off + sizeof(RecBlockHeader) <= n) {
+    RecBlockHeader bh{};
+    std::memcpy(&bh, d + off, sizeof(bh));
+    off += sizeof(bh);
+    if (bh.magic != kRecBlockMagic || bh.bytes > n - off) break; // truncated tail
+    if (bh.kind == static_cast<std::uint32_t>(RecBlockKind::Frames) && bh.rows > 0) {
+      blocks_.push_back(BlockRef{off, bh.rows, bh.bytes, bh.t_first, bh.t_last});
+    } else if (bh.kind == static_cast<std::uint32_t>(RecBlockKind::Events)) {
+      if (rec_decode_events(d + off, bh.bytes, bh.rows, ev)) {
+        events_.insert(events_.end(), ev.begin(), ev.end());
+      }
+    }
+    off += bh.bytes;
+  }
+  std::stable_sort(events_.begin(), events_.end(),
+                   [](const RecordEvent& a, const RecordEvent& b){ return a.t < b.t; });
+  return !blocks_.empty();
+}
+
+bool ReplayLog::load_block_(std::size_t b) const {
+  if (b == cached_) return true;
+  const BlockRef& br = blocks_[b];
+  if (!rec_decode_frames(file_.data() + br.offset, br.bytes, br.rows, rows_)) {
+    cached_ = static_cast<std::size_t>(-1);
+    return false;
+  }
+  tick_start_.clear();
+  for (std::uint32_t i = 0; i < rows_.size(); ++i) {
+    if (i == 0 || rows_[i].tick != rows_[i - 1].tick) tick_start_.push_back(i);
+  }
+  cached_ = b;
+  return true;
+}
+
+bool ReplayLog::locate_(double t, std::size_t& tick_idx) const {
+  if (blocks_.empty()) return false;
+  // Stored times are quantized; a request for a tick's exact sim_time must hit it.
+  t += 0.5 / kRecTimeScale;
+  // First block whose range ends at or after t; if t is in a gap, use the previous block.
+  auto it = std::lower_bound(blocks_.begin(), blocks_.end(), t,
+                             [](const BlockRef& br, double v){ return br.t_last < v; });
+  std::size_t b = (it == blocks_.end()) ? blocks_.size() - 1
+                                        : static_cast<std::size_t>(it - blocks_.begin());
+  if (b > 0 && t < blocks_[b].t_first) --b;
+  if (!load_block_(b)) return false;
+
+  // Last tick starting at or before t (clamp to the first tick)
+  auto tk = std::upper_bound(tick_start_.begin(), tick_start_.end(), t,
+                             [&](double v, std::uint32_t row){ return v < rows_[row].t; });
+  tick_idx = (tk == tick_start_.begin()) ? 0
+                                         : static_cast<std::size_t>(tk - tick_start_.begin()) - 1;
+  return true;
+}
+
+std::uint64_t ReplayLog::tick_at(double t) const {
+  std::size_t ti = 0;
+  if (!locate_(t, ti)) return 0;
+  return rows_[tick_start_[ti]].tick;
+}
+
+bool ReplayLog::frame_at(double t, SimSnapshot& out) const {
+  std::size_t ti = 0;
+  if (!locate_(t, ti)) return false;
+  const std::size_t r0 = tick_start_[ti];
+  const std::size_t r1 = (ti + 1 < tick_start_.size()) ? tick_start_[ti + 1] : rows_.size();
+
+  out.sim_time = rows_[r0].t;
+  out.tick = rows_[r0].tick;
+  out.cars.resize(r1 - r0);
+  for (std::size_t r = r0; r < r1; ++r) {
+    const RecordRow& row = rows_[r];
+    CarPose cp{};
+    cp.id = row.id;
+    cp.x = row.x;
+    cp.y = row.y;
+    cp.heading_rad = row.heading_rad;
+    cp.s = row.s;
+    cp.lap = row.lap;
+    cp.speed_mps = row.speed_mps;
+    out.cars[r - r0] = cp;
+  }
+
+  // Back-compat fill primary from car id 0 (if present) or index 0
+  if (!out.cars.empty()) {
+    const CarPose* primary = &out.cars.front();
+    for (const auto& c : out.cars) if (c.id == 0u) { primary = &c; break; }
+    out.x = primary->x; out.y = primary->y; out.heading_rad = primary->heading_rad;
+    out.s = primary->s; out.lap = primary->lap;
+  }
+  return true;
+}
+
+// ---- ReplaySource ----
+
+void ReplaySource::seek(double t) {
+  t_ = std::clamp(t, log_.t_begin(), log_.t_end());
+  ++seq_;
+}
+
+void ReplaySource::advance(double wall_dt) {
+  if (paused_ || wall_dt <= 0.0) return;
+  t_ = std::min(log_.t_end(), t_ + wall_dt * warp_);
+}
+
+bool ReplaySource::try_consume_latest(std::uint64_t& cursor, SimSnapshot& out) {
+  // Cursor key: recorded tick, salted with the seek sequence.
+  const std::uint64_t key = log_.tick_at(t_) ^ (seq_ << 48);
+  if (key == cursor) return false;
+  if (!log_.frame_at(t_, out)) return false;
+  cursor = key;
+  return true;
+}
+
+} // namespace f1tm
@@ -0,0 +1,76 @@
+#include <f1tm/sampling.hpp>
+
+namespace f1tm {
+
+namespace {
+
+// Joe & Kuo (new-joe-kuo-6.21201), dimensions 2..8: degree s, coefficients a, initial m.
+struct DirectionInit { unsigned s; unsigned a; std::uint32_t m[5]; };
+constexpr DirectionInit kInit[SobolSequence::kMaxDims - 1] = {
+  {1, 0, {1}},
+  {2, 1, {1, 3}},
+  {3, 1, {1, 3, 1}},
+  {3, 2, {1, 1, 1}},
+  {4, 1, {1, 1, 3, 3}},
+  {4, 4, {1, 3, 5, 13}},
+  {5, 2, {1, 1, 5, 5, 17}},
+};
+
+const SobolSequence& sobol() {
+  static const SobolSequence seq;
+  return seq;
+}
+
+} // namespace
+
+SobolSequence::SobolSequence() {
+  constexpr unsigned B = kBits;
+  for (unsigned i = 0; i < B; ++i) v_[0][i] = std::uint32_t{1} << (B - 1 - i);
+  for (std::size_t d = 1; d < kMaxDims; ++d) {
+    const DirectionInit& in = kInit[d - 1];
+    std::uint32_t* v = v_[d];
+    for (unsigned i = 0; i < in.s; ++i) v[i] = in.m[i] << (B - 1 - i);
+    for (unsigned i = in.s; i < B; ++i) {
+      std::uint32_t x = v[i - in.s] ^ (v[i - in.s] >> in.s);
+      for (unsigned k = 1; k < in.s; ++k) {
+        if ((in.a >> (in.s - 1 - k)) & 1u) x ^= v[i - k];
+      }
+      v[i] = x;
+    }
+  }
+}
+
+std::uint32_t SobolSequence::point_bits(std::uint64_t n, std::size_t d) const {
+  std::uint64_t g = n ^ (n >> 1); // Gray code
+  std::uint32_t x = 0;
+  for (unsigned i = 0; g != 0 && i < kBits; ++i, g >>= 1) {
+    if (g & 1u) x ^= v_[d][i];
+  }
+  return x;
+}
+
+ScenarioSampler::ScenarioSampler(SamplingMode mode, const CounterRng& rng)
+  : mode_(mode), rng_(rng) {
+  const CounterRng shifts = rng.split(0x50B0);
+  for (std::size_t d = 0; d < SobolSequence::kMaxDims; ++d) {
+    shift_[d] = std::uint32_t(shifts.bits(0, d) >> 32);
+  }
+}
+
+double ScenarioSampler::uniform(std::uint64_t scenario, std::size_t dim) const {
+  switch (mode_) {
+    case SamplingMode::Antithetic: {
+      const double u = rng_.uniform(scenario >> 1, dim);
+      return (scenario & 1u) ? 1.0 - u : u;
+    }
+    case SamplingMode::Sobol:
+      if (dim < SobolSequence::kMaxDims) {
+        return double(sobol().point_bits(scenario, dim) ^ shift_[dim]) * 0x1.0p-32;
+      }
+      return rng_.uniform(scenario, dim);
+    default:
+      return rng_.uniform(scenario, dim);
+  }
+}
+
+} // namespace f1tm
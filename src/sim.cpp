@@ -2,12 +2,26 @@
 
 namespace f1tm {
 
-void SimServer::add_car(CarId id, double speed_mps, double s0, std::uint64_t laps0) {
+void SimServer::set_track_path(const TrackPath& p) {
+  path_ = p;
+  use_path_ = true;
+  if (use_profile_) profile_ = SpeedProfile::build(p, profile_params_);
+}
+
+void SimServer::enable_speed_profile(const SpeedProfileParams& params) {
+  use_profile_ = true;
+  profile_params_ = params;
+  profile_ = (use_path_ && path_.has_value()) ? SpeedProfile::build(*path_, params) : SpeedProfile{};
+}
+
+void SimServer::add_car(CarId id, double speed_mps, double s0, std::uint64_t laps0,
+                        double lateral0) {
   CarState cs;
   cs.id = id;
   cs.speed_mps = speed_mps;
   cs.s = s0;
   cs.laps = laps0;
+  cs.lateral_m = lateral0;
   cars_.push_back(cs);
 }
 
@@ -37,7 +51,9 @@ double SimServer::track_length() const {
 void SimServer::step(double dt_sec) {
   const double C = track_length();
   if (C <= 0.0 || dt_sec <= 0.0) return;
+  const bool profiled = use_profile_ && use_path_ && !profile_.empty();
   for (auto& c : cars_) {
+    if (profiled) c.speed_mps = profile_.speed_at(c.s) * c.perf;
     if (c.speed_mps <= 0.0) continue;
     c.s += c.speed_mps * dt_sec;
     while (c.s >= C) {
@@ -47,46 +63,29 @@ void SimServer::step(double dt_sec) {
   }
 }
 
+void SimServer::pose_at_(double s, double lateral, double& x, double& y, double& heading_rad) const {
+  if (use_path_ && path_.has_value() && !path_->empty())
+    path_->sample_pose(s, lateral, x, y, heading_rad);
+  else
+    s_to_pose_circle(track, s, lateral, x, y, heading_rad);
+}
+
 void SimServer::sample_pose(double& x, double& y, double& heading_rad) const {
-  if (!cars_.empty()) {
-    if (use_path_ && path_.has_value() && !path_->empty())
-      path_->sample_pose(cars_[0].s, x, y, heading_rad);
-    else
-      s_to_pose_circle(track, cars_[0].s, x, y, heading_rad);
-  } else {
-    if (use_path_ && path_.has_value() && !path_->empty())
-      path_->sample_pose(0.0, x, y, heading_rad);
-    else
-      s_to_pose_circle(track, 0.0, x, y, heading_rad);
-  }
+  if (!cars_.empty()) pose_at_(cars_[0].s, cars_[0].lateral_m, x, y, heading_rad);
+  else                pose_at_(0.0, 0.0, x, y, heading_rad);
 }
 
 void SimServer::sample_pose_index(std::size_t idx, double& x, double& y, double& heading_rad) const {
-  if (idx < cars_.size()) {
-    if (use_path_ && path_.has_value() && !path_->empty())
-      path_->sample_pose(cars_[idx].s, x, y, heading_rad);
-    else
-      s_to_pose_circle(track, cars_[idx].s, x, y, heading_rad);
-  } else {
-    if (use_path_ && path_.has_value() && !path_->empty())
-      path_->sample_pose(0.0, x, y, heading_rad);
-    else
-      s_to_pose_circle(track, 0.0, x, y, heading_rad);
-  }
+  if (idx < cars_.size()) pose_at_(cars_[idx].s, cars_[idx].lateral_m, x, y, heading_rad);
+  else                    pose_at_(0.0, 0.0, x, y, heading_rad);
 }
 
 bool SimServer::sample_pose_for(CarId id, double& x, double& y, double& heading_rad) const {
   for (const auto& c : cars_) if (c.id == id) {
-    if (use_path_ && path_.has_value() && !path_->empty())
-      path_->sample_pose(c.s, x, y, heading_rad);
-    else
-      s_to_pose_circle(track, c.s, x, y, heading_rad);
+    pose_at_(c.s, c.lateral_m, x, y, heading_rad);
     return true;
   }
-  if (use_path_ && path_.has_value() && !path_->empty())
-    path_->sample_pose(0.0, x, y, heading_rad);
-  else
-    s_to_pose_circle(track, 0.0, x, y, heading_rad);
+  pose_at_(0.0, 0.0, x, y, heading_rad);
   return false;
 }
 
@@ -1,6 +1,8 @@
 #include <f1tm/sim_runner.hpp>
 #include <chrono>
+#include <ctime>
 #include <algorithm>
+#include <string>
 #include <vector>
 #include <f1tm/telemetry.hpp>
 
@@ -21,6 +23,19 @@ static std::vector<double> grid_s_positions_(std::size_t n, double circumference
   return s;
 }
 
+static std::string recording_path_() {
+  std::time_t t = std::time(nullptr);
+  std::tm tm{};
+#if defined(_WIN32)
+  localtime_s(&tm, &t);
+#else
+  localtime_r(&t, &tm);
+#endif
+  char buf[32];
+  std::strftime(buf, sizeof(buf), "%Y%m%d_%H%M%S", &tm);
+  return std::string("race_") + buf + ".f1rec";
+}
+
 TrackPath SimRunner::make_preset_(TrackPreset p) {
   // Control polygon describing the general shape (closed loop, rough corners)
   std::vector<Vec2> ctrl;
@@ -125,18 +140,35 @@ void SimRunner::set_default_cars(std::size_t n) {
   const double C = path_.empty() ? track_.circumference_m() : path_.length();
   // Typical F1 grid spacing along centerline ~9 m; small stagger between lanes ~3 m.
   const auto s_positions = grid_s_positions_(n, C, /*row_gap_m*/ 9.0, /*lane_gap_m*/ 3.0);
+  // Two-wide grid: pole side right of the centerline, off side left (matches grid boxes).
+  const double lane_off_m = 3.0;
   for (std::size_t i = 0; i < n; ++i) {
-    const double base = 62.0;                  // base speed
+    const double base = 62.0;                  // base speed (circle track fallback)
     const double jitter = 3.0 * double(i % 4); // 0,3,6,9 pattern
     initial_cars_.push_back(CarInit{
       static_cast<CarId>(i),
       base + jitter,
       s_positions[i],
-      0
+      0,
+      (i % 2 == 0) ? -lane_off_m : lane_off_m,
+      0.94 + 0.02 * double(i % 4)              // 0.94..1.00 of the speed profile
     });
   }
 }
 
+void SimRunner::add_initial_cars_(SimServer& sim) const {
+  for (const auto& c : initial_cars_) {
+    CarState cs;
+    cs.id = c.id;
+    cs.speed_mps = c.speed_mps;
+    cs.s = c.s0;
+    cs.laps = c.laps0;
+    cs.lateral_m = c.lateral0;
+    cs.perf = c.perf;
+    sim.add_car(cs);
+  }
+}
+
 void SimRunner::request_reseed(std::size_t n) {
   pending_reset_n_.store(n, std::memory_order_relaxed);
   pending_reset_.store(true, std::memory_order_release);
@@ -166,27 +198,35 @@ void SimRunner::stop() {
   if (!running_.load()) return;
   running_.store(false);
   if (th_.joinable()) th_.join();
+  recorder_.join();
 }
 
 void SimRunner::thread_main_() {
   SimServer sim;
   sim.track = track_;
+  sim.enable_speed_profile(); // corner-limited speeds on path tracks
   if (!path_.empty()) sim.set_track_path(path_);
   sim.clear_cars();
-  for (const auto& c : initial_cars_) {
-    sim.add_car(c.id, c.speed_mps, c.s0, c.laps0);
-  }
+  add_initial_cars_(sim);
 
-  TelemetrySink telem;
+  TelemetrySink telem(mini_sectors());
+  std::vector<std::uint64_t> lap_seen; // per car index, for recorder lap events
 
   using clock = std::chrono::steady_clock;
   const double base_dt = 1.0 / 240.0; // 240 Hz wall cadence
   const auto   tick_ns = std::chrono::nanoseconds((long long)(base_dt * 1e9));
-  auto next = clock::now();
+  auto now_ns = [] {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now().time_since_epoch()).count();
+  };
+  TickScheduler sched(tick_stats_, tick_ns.count(), catch_up_.load(std::memory_order_relaxed));
+  sched.start(now_ns());
   double sim_time = 0.0;
   std::uint64_t tick = 0;
 
   while (running_.load(std::memory_order_relaxed)) {
+    sched.set_policy(catch_up_.load(std::memory_order_relaxed));
+    const std::uint32_t periods = sched.begin_tick(now_ns()); // > 1 only when dropping ticks
+
     // Handle track preset change
     if (pending_preset_change_.load(std::memory_order_acquire)) {
       pending_preset_change_.store(false, std::memory_order_relaxed);
@@ -198,10 +238,12 @@ void SimRunner::thread_main_() {
         set_default_cars(initial_cars_.size() ? initial_cars_.size() : 8);
         sim.clear_cars();
         sim.set_track_path(path_);
-        for (const auto& c : initial_cars_) sim.add_car(c.id, c.speed_mps, c.s0, c.laps0);
+        add_initial_cars_(sim);
         sim_time = 0.0;
         tick = 0;
-        telem = TelemetrySink{}; // reset telemetry
+        telem = TelemetrySink{mini_sectors()}; // reset telemetry
+        recorder_.stop();        // recorded time must stay monotone
+        lap_seen.clear();
       }
     }
 
@@ -212,14 +254,33 @@ void SimRunner::thread_main_() {
       // Rebuild initial cars and reset sim (keep current preset/path)
       set_default_cars(n);
       sim.clear_cars();
-      for (const auto& c : initial_cars_) sim.add_car(c.id, c.speed_mps, c.s0, c.laps0);
+      add_initial_cars_(sim);
       sim_time = 0.0;
       tick = 0;
-      telem = TelemetrySink{}; // reset telemetry
+      telem = TelemetrySink{mini_sectors()}; // reset telemetry
+      recorder_.stop();
+      lap_seen.clear();
+    }
+
+    // Handle recording start/stop
+    if (const int rec = pending_record_.exchange(-1, std::memory_order_acq_rel); rec >= 0) {
+      if (rec == 1 && !recorder_.recording()) {
+        const auto track_id = static_cast<std::uint32_t>(preset_) + 1;
+        if (recorder_.writing()) {
+          // Previous file still being finished: retry next tick unless a newer request came.
+          int none = -1;
+          pending_record_.compare_exchange_strong(none, 1, std::memory_order_acq_rel);
+        } else if (recorder_.start(recording_path_(), track_id)) {
+          lap_seen.assign(sim.car_count(), 0);
+          for (std::size_t i = 0; i < sim.car_count(); ++i) lap_seen[i] = sim.car_by_index(i)->laps;
+        }
+      }
+      if (rec == 0) recorder_.stop();
     }
 
+    StageStopwatch sw(profiler_);
     const double warp = time_scale.load(std::memory_order_relaxed);
-    const double dt_eff = base_dt * (warp < 0.0 ? 0.0 : warp);
+    const double dt_eff = base_dt * (warp < 0.0 ? 0.0 : warp) * periods;
 
     if (dt_eff > 0.0) {
       sim.step(dt_eff);
@@ -228,9 +289,18 @@ void SimRunner::thread_main_() {
     } else {
       ++tick; // publish heartbeats even when paused
     }
+    sw.lap(kStageStep);
 
     // Update telemetry after ticking the sim
     telem.update(sim, sim_time);
+    if (recorder_.recording() && dt_eff > 0.0) {
+      record_lap_events(recorder_, sim, telem, lap_seen, sim_time); // lap counter advanced
+    }
+    if (pending_summary_.load(std::memory_order_acquire)) {
+      pending_summary_.store(false, std::memory_order_relaxed);
+      summary_buffer_.publish(telem.summary(sim_time));
+    }
+    sw.lap(kStageTelemetry);
 
     // Publish MULTI-CAR snapshot (with gaps & sectors)
     SimSnapshot s{};
@@ -256,9 +326,10 @@ void SimRunner::thread_main_() {
       cp.id = car->id;
       cp.x = x; cp.y = y; cp.heading_rad = heading;
       cp.s = car->s; cp.lap = car->laps;
+      cp.speed_mps = car->speed_mps;
       // Fill telemetry (laps + sectors)
       TelemetryTimes tt{};
-      if (telem.get(cp.id, tt)) {
+      if (telem.get_index(i, tt)) {
         cp.last_lap_time = tt.last_lap;
         cp.best_lap_time = tt.best_lap;
         cp.s1_last = tt.s_last[0]; cp.s2_last = tt.s_last[1]; cp.s3_last = tt.s_last[2];
@@ -294,11 +365,21 @@ void SimRunner::thread_main_() {
       s.s = primary->s; s.lap = primary->lap;
     }
 
-    buffer_.publish(s);
+    sw.lap(kStageSnapshot);
 
-    next += tick_ns;
-    std::this_thread::sleep_until(next);
+    if (dt_eff > 0.0) recorder_.record(s); // lock-free handoff; drops (and counts) if full
+    buffer_.publish(s);
+    sw.lap(kStagePublish);
+    sw.total(kStageTick);
+
+    // A late tick finds its wake time already past and runs again at once (Burst), or
+    // the scheduler skipped (Drop) or re-anchored (SlowDown) the schedule.
+    const std::int64_t wake = sched.end_tick(now_ns());
+    std::this_thread::sleep_until(
+        clock::time_point(std::chrono::duration_cast<clock::duration>(std::chrono::nanoseconds(wake))));
+    sched.woke(now_ns());
   }
+  recorder_.stop(); // SimRunner::stop() waits for the file after joining this thread
 }
 
 } // namespace f1tm
@@ -0,0 +1,69 @@
+#include <f1tm/speed_profile.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace f1tm {
+
+// Menger curvature of the circle through a, b, c (0 if degenerate).
+static double menger_curvature(const Vec2& a, const Vec2& b, const Vec2& c) {
+  const double abx = b.x - a.x, aby = b.y - a.y;
+  const double acx = c.x - a.x, acy = c.y - a.y;
+  const double cross = abx * acy - aby * acx; // 2 * signed area
+  const double ab = std::hypot(abx, aby);
+  const double bc = std::hypot(c.x - b.x, c.y - b.y);
+  const double ca = std::hypot(acx, acy);
+  const double denom = ab * bc * ca;
+  return denom > 0.0 ? 2.0 * std::fabs(cross) / denom : 0.0;
+}
+
+SpeedProfile SpeedProfile::build(const TrackPath& path, const SpeedProfileParams& params) {
+  SpeedProfile sp;
+  if (path.empty() || path.length() <= 0.0) return sp;
+
+  const double L = path.length();
+  const double ds_req = params.ds_m > 0.0 ? params.ds_m : 1.0;
+  const std::size_t n = std::max<std::size_t>(3, static_cast<std::size_t>(std::ceil(L / ds_req)));
+  const double ds = L / static_cast<double>(n);
+  const double win = std::max(ds, params.curvature_window_m);
+  const double v_max = std::max(1.0, params.v_max_mps);
+  const double a_lat = std::max(0.0, params.a_lat_mps2);
+  const double a_acc = std::max(0.0, params.a_accel_mps2);
+  const double a_brk = std::max(0.0, params.a_brake_mps2);
+
+  sp.length_ = L;
+  sp.inv_length_ = 1.0 / L;
+  sp.inv_ds_ = 1.0 / ds;
+  sp.k_.resize(n);
+  sp.v_.resize(n);
+
+  // Curvature and cornering limit per cell
+  for (std::size_t i = 0; i < n; ++i) {
+    const double s = static_cast<double>(i) * ds;
+    Vec2 a, b, c;
+    double h;
+    path.sample_pose(s - win, a.x, a.y, h);
+    path.sample_pose(s,       b.x, b.y, h);
+    path.sample_pose(s + win, c.x, c.y, h);
+    const double k = menger_curvature(a, b, c);
+    sp.k_[i] = k;
+    sp.v_[i] = (k > 0.0) ? std::min(v_max, std::sqrt(a_lat / k)) : v_max;
+  }
+
+  // Acceleration (forward) and braking (backward) passes. Two laps each so the
+  // constraint propagates across the start/finish wrap.
+  for (std::size_t j = 1; j < 2 * n; ++j) {
+    const double& prev = sp.v_[(j - 1) % n];
+    double& cur = sp.v_[j % n];
+    cur = std::min(cur, std::sqrt(prev * prev + 2.0 * a_acc * ds));
+  }
+  for (std::size_t j = 2 * n - 1; j-- > 0;) {
+    const double& next = sp.v_[(j + 1) % n];
+    double& cur = sp.v_[j % n];
+    cur = std::min(cur, std::sqrt(next * next + 2.0 * a_brk * ds));
+  }
+
+  for (double v : sp.v_) sp.lap_time_ += ds / std::max(v, 1e-6);
+  return sp;
+}
+
+} // namespace f1tm
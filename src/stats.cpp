@@ -0,0 +1,76 @@
+#include <f1tm/stats.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace f1tm {
+
+void RunningStats::add(double x) {
+  ++n_;
+  sum_ += x;
+  if (n_ == 1) { min_ = max_ = x; }
+  else { min_ = std::min(min_, x); max_ = std::max(max_, x); }
+  const double d = x - mean_;
+  mean_ += d / double(n_);
+  m2_ += d * (x - mean_);
+}
+
+double RunningStats::stddev() const {
+  return std::sqrt(variance());
+}
+
+P2Quantile::P2Quantile(double p) : p_(std::clamp(p, 0.0, 1.0)) {}
+
+void P2Quantile::add(double x) {
+  if (n_ < 5) {
+    q_[n_++] = x;
+    if (n_ == 5) {
+      std::sort(q_, q_ + 5);
+      for (int i = 0; i < 5; ++i) pos_[i] = double(i + 1);
+      want_[0] = 1.0; want_[1] = 1.0 + 2.0 * p_; want_[2] = 1.0 + 4.0 * p_;
+      want_[3] = 3.0 + 2.0 * p_; want_[4] = 5.0;
+      dwant_[0] = 0.0; dwant_[1] = p_ * 0.5; dwant_[2] = p_;
+      dwant_[3] = (1.0 + p_) * 0.5; dwant_[4] = 1.0;
+    }
+    return;
+  }
+  ++n_;
+
+  // Locate the cell containing x, extending the extremes if needed
+  int k;
+  if (x < q_[0])       { q_[0] = x; k = 0; }
+  else if (x >= q_[4]) { q_[4] = x; k = 3; }
+  else { k = 0; while (k < 3 && x >= q_[k + 1]) ++k; }
+
+  for (int i = k + 1; i < 5; ++i) pos_[i] += 1.0;
+  for (int i = 0; i < 5; ++i) want_[i] += dwant_[i];
+
+  // Adjust the three middle markers
+  for (int i = 1; i <= 3; ++i) {
+    const double d = want_[i] - pos_[i];
+    if ((d >= 1.0 && pos_[i + 1] - pos_[i] > 1.0) || (d <= -1.0 && pos_[i - 1] - pos_[i] < -1.0)) {
+      const double s = d >= 0.0 ? 1.0 : -1.0;
+      const double qp = q_[i] + s / (pos_[i + 1] - pos_[i - 1]) *
+          ((pos_[i] - pos_[i - 1] + s) * (q_[i + 1] - q_[i]) / (pos_[i + 1] - pos_[i]) +
+           (pos_[i + 1] - pos_[i] - s) * (q_[i] - q_[i - 1]) / (pos_[i] - pos_[i - 1]));
+      if (q_[i - 1] < qp && qp < q_[i + 1]) {
+        q_[i] = qp;
+      } else {
+        const int j = i + int(s);
+        q_[i] += s * (q_[j] - q_[i]) / (pos_[j] - pos_[i]);
+      }
+      pos_[i] += s;
+    }
+  }
+}
+
+double P2Quantile::value() const {
+  if (n_ == 0) return 0.0;
+  if (n_ >= 5) return q_[2];
+  double tmp[5];
+  std::copy(q_, q_ + n_, tmp);
+  std::sort(tmp, tmp + n_);
+  const auto idx = static_cast<std::size_t>(std::lround(p_ * double(n_ - 1)));
+  return tmp[idx];
+}
+
+} // namespace f1tm
@@ -0,0 +1,142 @@
+#include <f1tm/strategy.hpp>
+#include <algorithm>
+#include <limits>
+#include <f1tm/pit.hpp>
+
+namespace f1tm {
+
+std::vector<StintParams> strategy_stints(const PitStrategy& s, const std::vector<Compound>& compounds) {
+  std::vector<StintParams> out;
+  out.reserve(s.stints.size());
+  for (const auto& st : s.stints) {
+    const Compound& c = compounds[st.compound];
+    out.push_back(StintParams{st.laps, c.baseLap, c.degradationPerLap});
+  }
+  return out;
+}
+
+namespace {
+
+constexpr double kInf = std::numeric_limits<double>::infinity();
+
+class Search {
+public:
+  Search(int laps, const std::vector<Compound>& comp, const StrategySearchOptions& opt, double pit)
+    : N_(laps), C_(comp.size()), opt_(opt), pit_(pit) {
+    // cost_[c][L]: stint of L laps on compound c (inf beyond its tyre life)
+    cost_.assign(C_ * std::size_t(N_ + 1), kInf);
+    for (std::size_t c = 0; c < C_; ++c) {
+      const int max_l = comp[c].maxLaps > 0 ? std::min(comp[c].maxLaps, N_) : N_;
+      for (int L = opt_.min_stint_laps; L <= max_l; ++L) {
+        cost_[c * std::size_t(N_ + 1) + std::size_t(L)] =
+            estimate_stint_time(StintParams{L, comp[c].baseLap, comp[c].degradationPerLap});
+      }
+    }
+    // bound_[s][r]: best time for r laps with at most s stops, any compounds
+    const int S = opt_.max_stops;
+    bound_.assign(std::size_t(S + 1) * std::size_t(N_ + 1), kInf);
+    for (int r = 1; r <= N_; ++r) {
+      double b = kInf;
+      for (std::size_t c = 0; c < C_; ++c) b = std::min(b, cost(c, r));
+      at(0, r) = b;
+    }
+    for (int s = 1; s <= S; ++s) {
+      for (int r = 1; r <= N_; ++r) {
+        double b = at(s - 1, r);
+        for (int L = 1; L < r; ++L) {
+          double first = kInf;
+          for (std::size_t c = 0; c < C_; ++c) first = std::min(first, cost(c, L));
+          b = std::min(b, first + pit_ + at(s - 1, r - L));
+        }
+        at(s, r) = b;
+      }
+    }
+  }
+
+  std::vector<PitStrategy> run() {
+    plan_.clear();
+    dfs_(0, 0, N_, N_, 0u, 0.0);
+    std::sort_heap(best_.begin(), best_.end(), worse_);
+    return std::move(best_);
+  }
+
+private:
+  double cost(std::size_t c, int L) const { return cost_[c * std::size_t(N_ + 1) + std::size_t(L)]; }
+  double& at(int s, int r) { return bound_[std::size_t(s) * std::size_t(N_ + 1) + std::size_t(r)]; }
+  double at(int s, int r) const { return bound_[std::size_t(s) * std::size_t(N_ + 1) + std::size_t(r)]; }
+
+  // Current K-th best total (inf until K strategies are known).
+  double threshold_() const {
+    return best_.size() < opt_.top_k ? kInf : best_.front().total_time;
+  }
+
+  bool compounds_ok_(unsigned mask) const {
+    return !opt_.require_two_compounds || C_ < 2 || (mask & (mask - 1)) != 0;
+  }
+
+  void offer_(double total) {
+    if (total >= threshold_()) return;
+    if (best_.size() == opt_.top_k) {
+      std::pop_heap(best_.begin(), best_.end(), worse_);
+      best_.pop_back();
+    }
+    best_.push_back(PitStrategy{total, plan_});
+    std::push_heap(best_.begin(), best_.end(), worse_);
+  }
+
+  // `remaining` laps are unplanned; the next stint uses compound >= c_min and, on
+  // compound c_min itself, at most l_max laps (canonical order).
+  void dfs_(int stops, std::size_t c_min, int l_max, int remaining, unsigned mask, double partial) {
+    for (std::size_t c = c_min; c < C_; ++c) {
+      const int cap = (c == c_min) ? l_max : N_;
+      const unsigned m = mask | (1u << c);
+      // Last stint
+      if (remaining <= cap) {
+        const double t = cost(c, remaining);
+        if (t < kInf && compounds_ok_(m)) {
+          plan_.push_back(StintPlan{c, remaining});
+          offer_(partial + t);
+          plan_.pop_back();
+        }
+      }
+      if (stops == opt_.max_stops) continue;
+      // Another stop after a stint of L laps
+      const int l_hi = std::min(cap, remaining - opt_.min_stint_laps);
+      for (int L = l_hi; L >= opt_.min_stint_laps; --L) {
+        const double t = partial + cost(c, L) + pit_;
+        if (!(t + at(opt_.max_stops - stops - 1, remaining - L) < threshold_())) continue;
+        plan_.push_back(StintPlan{c, L});
+        dfs_(stops + 1, c, L, remaining - L, m, t);
+        plan_.pop_back();
+      }
+    }
+  }
+
+  static bool worse_(const PitStrategy& a, const PitStrategy& b) { return a.total_time < b.total_time; }
+
+  int N_;
+  std::size_t C_;
+  StrategySearchOptions opt_;
+  double pit_;
+  std::vector<double> cost_;
+  std::vector<double> bound_;
+  std::vector<StintPlan> plan_;
+  std::vector<PitStrategy> best_; // max-heap on total_time, size <= top_k
+};
+
+} // namespace
+
+std::vector<PitStrategy> optimize_pit_strategy(int race_laps,
+                                               const Track& track,
+                                               const std::vector<Compound>& compounds,
+                                               const StrategySearchOptions& opt) {
+  if (race_laps <= 0 || compounds.empty() || compounds.size() > 16) return {};
+  if (opt.top_k == 0 || opt.max_stops < 0 || opt.min_stint_laps < 1) return {};
+  for (const auto& c : compounds) {
+    if (!(c.baseLap > 0.0) || !(c.degradationPerLap >= 0.0) || c.maxLaps < 0) return {};
+  }
+  const double pit = pit_stop_loss_under(track_pit_params(track), opt.lane_factor);
+  return Search(race_laps, compounds, opt, pit).run();
+}
+
+} // namespace f1tm
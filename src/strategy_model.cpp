@@ -0,0 +1,94 @@
+#include <f1tm/strategy_model.hpp>
+#include <algorithm>
+
+namespace f1tm {
+
+std::optional<StrategyModel> StrategyModel::create(std::vector<StintParams> stints,
+                                                   std::vector<PitParams> pits,
+                                                   std::vector<double> lane_factors) {
+  if (stints.empty() || pits.size() + 1 != stints.size()) return std::nullopt;
+  if (lane_factors.empty()) lane_factors.assign(pits.size(), 1.0);
+  if (lane_factors.size() != pits.size()) return std::nullopt;
+
+  StrategyModel m;
+  m.stints_ = std::move(stints);
+  m.pits_ = std::move(pits);
+  m.factors_ = std::move(lane_factors);
+  const std::size_t n = 2 * m.stints_.size() - 1;
+  m.terms_.resize(n);
+  for (std::size_t i = 0; i < m.stints_.size(); ++i) {
+    m.terms_[2 * i] = estimate_stint_time(m.stints_[i]);
+    m.laps_ += std::max(0, m.stints_[i].laps);
+    if (i < m.pits_.size()) m.terms_[2 * i + 1] = pit_stop_loss_under(m.pits_[i], m.factors_[i]);
+  }
+  // O(n) Fenwick build
+  m.tree_.assign(n + 1, 0.0);
+  for (std::size_t k = 1; k <= n; ++k) {
+    m.tree_[k] += m.terms_[k - 1];
+    const std::size_t parent = k + (k & (~k + 1));
+    if (parent <= n) m.tree_[parent] += m.tree_[k];
+  }
+  return m;
+}
+
+double StrategyModel::set_term_(std::size_t k, double v) {
+  const double d = v - terms_[k];
+  terms_[k] = v;
+  for (std::size_t j = k + 1; j < tree_.size(); j += j & (~j + 1)) tree_[j] += d;
+  return d;
+}
+
+double StrategyModel::prefix_(std::size_t n) const {
+  double s = 0.0;
+  for (std::size_t j = n; j > 0; j -= j & (~j + 1)) s += tree_[j];
+  return s;
+}
+
+std::optional<double> StrategyModel::set_stint(std::size_t i, const StintParams& s) {
+  if (i >= stints_.size()) return std::nullopt;
+  laps_ += std::max(0, s.laps) - std::max(0, stints_[i].laps);
+  stints_[i] = s;
+  return set_term_(2 * i, estimate_stint_time(s));
+}
+
+std::optional<double> StrategyModel::set_stint_laps(std::size_t i, int laps) {
+  if (i >= stints_.size()) return std::nullopt;
+  StintParams s = stints_[i];
+  s.laps = laps;
+  return set_stint(i, s);
+}
+
+std::optional<double> StrategyModel::set_stop(std::size_t i, const PitParams& p) {
+  if (i >= pits_.size()) return std::nullopt;
+  pits_[i] = p;
+  return set_term_(2 * i + 1, pit_stop_loss_under(p, factors_[i]));
+}
+
+std::optional<double> StrategyModel::set_lane_factor(std::size_t i, double f) {
+  if (i >= pits_.size()) return std::nullopt;
+  factors_[i] = f;
+  return set_term_(2 * i + 1, pit_stop_loss_under(pits_[i], f));
+}
+
+std::optional<double> StrategyModel::move_stop_delta(std::size_t i, int laps) const {
+  if (i >= pits_.size()) return std::nullopt;
+  StintParams a = stints_[i], b = stints_[i + 1];
+  a.laps += laps;
+  b.laps -= laps;
+  if (a.laps < 0 || b.laps < 0) return std::nullopt;
+  return (estimate_stint_time(a) - terms_[2 * i]) + (estimate_stint_time(b) - terms_[2 * i + 2]);
+}
+
+std::optional<double> StrategyModel::move_stop(std::size_t i, int laps) {
+  if (i >= pits_.size()) return std::nullopt;
+  StintParams& a = stints_[i];
+  StintParams& b = stints_[i + 1];
+  if (a.laps + laps < 0 || b.laps - laps < 0) return std::nullopt;
+  laps_ += (std::max(0, a.laps + laps) - std::max(0, a.laps)) +
+           (std::max(0, b.laps - laps) - std::max(0, b.laps));
+  a.laps += laps;
+  b.laps -= laps;
+  return set_term_(2 * i, estimate_stint_time(a)) + set_term_(2 * i + 2, estimate_stint_time(b));
+}
+
+} // namespace f1tm
@@ -0,0 +1,214 @@
+#include <f1tm/telemetry.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace f1tm {
+
+TelemetrySink::TelemetrySink(std::size_t mini_sectors) {
+  if (mini_sectors == 0) mini_sectors = 1;
+  mini_sectors_ = mini_sectors;
+  const double eps = 1e-9;
+  for (std::size_t i = 1; i <= mini_sectors; ++i) {
+    fractions_.push_back(double(i) / double(mini_sectors));
+  }
+  // Merge the classic sector lines (1/3, 2/3); the lap line closes sector 3.
+  for (int k = 1; k < kSectors; ++k) {
+    const double f = double(k) / double(kSectors);
+    auto it = std::find_if(fractions_.begin(), fractions_.end(),
+                           [&](double x){ return std::fabs(x - f) < eps; });
+    if (it == fractions_.end()) fractions_.push_back(f);
+  }
+  std::sort(fractions_.begin(), fractions_.end());
+  sector_end_.assign(fractions_.size(), -1);
+  mini_end_.assign(fractions_.size(), -1);
+  for (std::size_t i = 0; i < fractions_.size(); ++i) {
+    for (int k = 1; k <= kSectors; ++k) {
+      if (std::fabs(fractions_[i] - double(k) / double(kSectors)) < eps) sector_end_[i] = k - 1;
+    }
+    const double m = fractions_[i] * double(mini_sectors);
+    if (std::fabs(m - std::round(m)) < eps * double(mini_sectors)) mini_end_[i] = int(std::lround(m)) - 1;
+  }
+}
+
+void TelemetrySink::build_lines_(double C) {
+  C_ = C;
+  lines_.resize(fractions_.size());
+  for (std::size_t i = 0; i < fractions_.size(); ++i) {
+    lines_[i] = Line{ fractions_[i] * C, sector_end_[i], mini_end_[i] };
+  }
+  lines_.back().s_m = C; // exact lap line
+}
+
+void TelemetrySink::add_slot_(const CarState& c, double now_time) {
+  State st{};
+  st.laps = c.laps;
+  st.started = false;            // ignore first lap-line crossing; start timing from there
+  st.lap_base = double(c.laps) * C_;
+  st.next_line = static_cast<std::uint32_t>(lines_.size() - 1);
+  st.next_line_prog = st.lap_base + C_;
+  st.prev_prog = double(c.laps) * C_ + c.s;
+  st.prev_time = now_time;
+  ids_.push_back(c.id);
+  st_.push_back(st);
+  mini_last_.resize(mini_last_.size() + mini_sectors_, -1.0);
+  mini_best_.resize(mini_best_.size() + mini_sectors_, -1.0);
+  lap_stats_.emplace_back();
+  sector_stats_.resize(sector_stats_.size() + kSectors);
+}
+
+void TelemetrySink::init_if_needed(const SimServer& sim, double now_time) {
+  if (initialized_) return;
+  initialized_ = true;
+  build_lines_(sim.track_length());
+  const std::size_t n = sim.car_count();
+  ids_.reserve(n);
+  st_.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    if (const auto* c = sim.car_by_index(i)) add_slot_(*c, now_time);
+  }
+}
+
+void TelemetrySink::cross_line_(std::size_t slot, double t) {
+  State& st = st_[slot];
+  const std::size_t K = lines_.size();
+  const std::size_t k = st.next_line;
+
+  if (!st.started) {
+    // First time crossing start/finish; start timing here and do not emit a lap or S3.
+    st.started = true;
+    st.lap_start_time = st.sector_start_time = st.mini_start_time = t;
+  } else {
+    if (const int m = lines_[k].mini_end; m >= 0) {
+      const std::size_t at = slot * mini_sectors_ + std::size_t(m);
+      const double mini = t - st.mini_start_time;
+      mini_last_[at] = mini;
+      if (mini_best_[at] < 0.0 || mini < mini_best_[at]) mini_best_[at] = mini;
+      st.mini_start_time = t;
+    }
+
+    if (const int sec = lines_[k].sector_end; sec >= 0) {
+      const double sector_time = t - st.sector_start_time;
+      st.s_last[sec] = sector_time;
+      if (st.s_best[sec] < 0.0 || sector_time < st.s_best[sec]) st.s_best[sec] = sector_time;
+      st.sector_start_time = t;
+      sector_stats_[slot * kSectors + std::size_t(sec)].add(sector_time);
+    }
+    if (k + 1 == K) {
+      const double lap_time = t - st.lap_start_time;
+      st.last_lap_time = lap_time;
+      if (st.best_lap_time < 0.0 || lap_time < st.best_lap_time) st.best_lap_time = lap_time;
+      st.lap_start_time = t;
+      lap_stats_[slot].add(lap_time);
+    }
+  }
+
+  if (k + 1 == K) {
+    st.lap_line_time = t;
+    st.lap_base += C_;
+    st.next_line = 0;
+  } else {
+    ++st.next_line;
+  }
+  st.next_line_prog = st.lap_base + lines_[st.next_line].s_m;
+}
+
+void TelemetrySink::update(const SimServer& sim, double now_time) {
+  init_if_needed(sim, now_time);
+  if (C_ <= 0.0) return;
+
+  const std::size_t n = sim.car_count();
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto* c = sim.car_by_index(i);
+    if (!c) continue;
+    if (i >= st_.size()) add_slot_(*c, now_time);
+    State& st = st_[i];
+    st.laps = c->laps;
+
+    const double prog = double(c->laps) * C_ + c->s;
+    // Common case: no timing line crossed this tick.
+    if (prog < st.next_line_prog - 1e-9) {
+      st.prev_prog = prog;
+      st.prev_time = now_time;
+      continue;
+    }
+    // Possibly several lines if dt is large. Each crossing time is interpolated
+    // linearly between (prev_prog, prev_time) and (prog, now_time).
+    const double dp = prog - st.prev_prog;
+    const double dt = now_time - st.prev_time;
+    while (prog >= st.next_line_prog - 1e-9) {
+      double u = dp > 0.0 ? (st.next_line_prog - st.prev_prog) / dp : 1.0;
+      u = std::clamp(u, 0.0, 1.0);
+      cross_line_(i, st.prev_time + u * dt);
+    }
+    st.prev_prog = prog;
+    st.prev_time = now_time;
+  }
+}
+
+bool TelemetrySink::get_index(std::size_t idx, TelemetryTimes& out) const {
+  if (idx >= st_.size()) return false;
+  const State& st = st_[idx];
+  const std::size_t K = mini_sectors_;
+  out.last_lap = st.last_lap_time;
+  out.best_lap = st.best_lap_time;
+  out.laps     = st.laps;
+  out.lap_line_time = st.lap_line_time;
+  for (int k = 0; k < kSectors; ++k) { out.s_last[k] = st.s_last[k]; out.s_best[k] = st.s_best[k]; }
+  out.mini_last = std::span<const double>(mini_last_.data() + idx * K, K);
+  out.mini_best = std::span<const double>(mini_best_.data() + idx * K, K);
+  return true;
+}
+
+bool TelemetrySink::get(CarId id, TelemetryTimes& out) const {
+  for (std::size_t i = 0; i < ids_.size(); ++i) {
+    if (ids_[i] == id) return get_index(i, out);
+  }
+  return false;
+}
+
+const TimeStats* TelemetrySink::lap_stats(std::size_t idx) const {
+  return idx < lap_stats_.size() ? &lap_stats_[idx] : nullptr;
+}
+
+const TimeStats* TelemetrySink::sector_stats(std::size_t idx, int sector) const {
+  if (idx >= lap_stats_.size() || sector < 0 || sector >= kSectors) return nullptr;
+  return &sector_stats_[idx * kSectors + std::size_t(sector)];
+}
+
+TimeSummary TimeSummary::from(const TimeStats& ts) {
+  TimeSummary out{};
+  out.count = ts.count();
+  if (out.count == 0) return out;
+  out.mean   = ts.moments.mean();
+  out.stddev = ts.moments.stddev();
+  out.min    = ts.moments.min();
+  out.max    = ts.moments.max();
+  out.p50    = ts.p50.value();
+  out.p90    = ts.p90.value();
+  return out;
+}
+
+RaceSummary TelemetrySink::summary(double finish_time) const {
+  std::vector<std::size_t> order(st_.size());
+  for (std::size_t i = 0; i < order.size(); ++i) order[i] = i;
+  std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b){
+    return st_[a].prev_prog > st_[b].prev_prog;
+  });
+
+  std::vector<CarSummary> cars;
+  cars.reserve(order.size());
+  for (std::size_t i : order) {
+    CarSummary cs{};
+    cs.id = ids_[i];
+    cs.laps = st_[i].laps;
+    cs.total_time = lap_stats_[i].moments.sum();
+    cs.lap = TimeSummary::from(lap_stats_[i]);
+    for (int k = 0; k < kSectors; ++k) {
+      cs.sector[k] = TimeSummary::from(sector_stats_[i * kSectors + std::size_t(k)]);
+    }
+    cars.push_back(cs);
+  }
+  return RaceSummary{finish_time, std::move(cars)};
+}
+
+} // namespace f1tm
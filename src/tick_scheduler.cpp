@@ -0,0 +1,91 @@
+#include <f1tm/tick_scheduler.hpp>
+#include <algorithm>
+
+namespace f1tm {
+
+namespace {
+
+constexpr std::int64_t kRateWindowNs = 1'000'000'000;
+
+void store_max(std::atomic<std::uint64_t>& m, std::uint64_t v) {
+  if (v > m.load(std::memory_order_relaxed)) m.store(v, std::memory_order_relaxed); // single writer
+}
+
+} // namespace
+
+void TickStats::reset() {
+  for (auto* c : {&ticks, &overruns, &late_ticks, &bursts, &dropped_ticks, &resyncs, &work_ns_last,
+                  &work_ns_max, &work_ns_total, &overshoot_ns_last, &overshoot_ns_max}) {
+    c->store(0, std::memory_order_relaxed);
+  }
+  tick_hz.store(0.0, std::memory_order_relaxed);
+}
+
+void TickScheduler::start(std::int64_t now_ns) {
+  deadline_ = now_ns;
+  tick_start_ = now_ns;
+  in_burst_ = false;
+  slept_ = false;
+  window_start_ = now_ns;
+  window_ticks_ = 0;
+}
+
+std::uint32_t TickScheduler::begin_tick(std::int64_t now) {
+  tick_start_ = now;
+  std::uint32_t periods = 1;
+  const std::int64_t behind = now - deadline_;
+  if (behind >= period_) {
+    stats_.late_ticks.fetch_add(1, std::memory_order_relaxed);
+    switch (policy_) {
+      case CatchUpPolicy::Burst:
+        if (!in_burst_) stats_.bursts.fetch_add(1, std::memory_order_relaxed);
+        in_burst_ = true;
+        break;
+      case CatchUpPolicy::Drop: {
+        // Skip every missed period; fold up to kMaxFoldedPeriods of them into this step.
+        const std::int64_t missed = behind / period_;
+        deadline_ += missed * period_;
+        periods += static_cast<std::uint32_t>(std::min<std::int64_t>(missed, kMaxFoldedPeriods - 1));
+        stats_.dropped_ticks.fetch_add(std::uint64_t(missed), std::memory_order_relaxed);
+        break;
+      }
+      case CatchUpPolicy::SlowDown:
+        deadline_ = now;
+        stats_.resyncs.fetch_add(1, std::memory_order_relaxed);
+        break;
+    }
+  } else {
+    in_burst_ = false;
+  }
+
+  stats_.ticks.fetch_add(1, std::memory_order_relaxed);
+  ++window_ticks_;
+  if (now - window_start_ >= kRateWindowNs) {
+    stats_.tick_hz.store(double(window_ticks_) * 1e9 / double(now - window_start_),
+                         std::memory_order_relaxed);
+    window_start_ = now;
+    window_ticks_ = 0;
+  }
+  return periods;
+}
+
+std::int64_t TickScheduler::end_tick(std::int64_t now) {
+  const auto work = std::uint64_t(std::max<std::int64_t>(0, now - tick_start_));
+  stats_.work_ns_last.store(work, std::memory_order_relaxed);
+  stats_.work_ns_total.fetch_add(work, std::memory_order_relaxed);
+  store_max(stats_.work_ns_max, work);
+
+  deadline_ += period_;
+  if (now > deadline_) stats_.overruns.fetch_add(1, std::memory_order_relaxed);
+  slept_ = now < deadline_;
+  return deadline_;
+}
+
+void TickScheduler::woke(std::int64_t now) {
+  if (!slept_) return; // no sleep: lateness shows up as late ticks, not overshoot
+  const auto over = std::uint64_t(std::max<std::int64_t>(0, now - deadline_));
+  stats_.overshoot_ns_last.store(over, std::memory_order_relaxed);
+  store_max(stats_.overshoot_ns_max, over);
+}
+
+} // namespace f1tm
@@ -1,66 +1,97 @@
 #include <f1tm/track.hpp>
+#include <f1tm/mapped_file.hpp>
 #include <algorithm>
+#include <charconv>
 #include <fstream>
 #include <sstream>
-#include <cctype>
 
 namespace f1tm {
 
-static std::string trim(std::string s) {
-  auto not_space = [](unsigned char c){ return !std::isspace(c); };
-  s.erase(s.begin(), std::find_if(s.begin(), s.end(), not_space));
-  s.erase(std::find_if(s.rbegin(), s.rend(), not_space).base(), s.end());
+namespace {
+
+// std::isspace in the "C" locale, without the locale lookup.
+inline bool is_space(char c) { return c == ' ' || (c >= '\t' && c <= '\r'); }
+
+std::string_view trim(std::string_view s) {
+  while (!s.empty() && is_space(s.front())) s.remove_prefix(1);
+  while (!s.empty() && is_space(s.back())) s.remove_suffix(1);
   return s;
 }
 
-static std::vector<std::string> split_csv_line(const std::string& line) {
-  // Simple CSV: no quoted fields; we keep parser tiny on purpose.
-  std::vector<std::string> cols;
-  std::string cur;
-  for (char c : line) {
-    if (c == ',') { cols.push_back(trim(cur)); cur.clear(); }
-    else { cur.push_back(c); }
+// Simple CSV: no quoted fields; we keep parser tiny on purpose. Keeps the first
+// kCols trimmed fields and returns the total field count.
+constexpr std::size_t kCols = 5;
+std::size_t split_csv_line(std::string_view line, std::string_view (&cols)[kCols]) {
+  std::size_t n = 0;
+  for (;;) {
+    const std::size_t comma = line.find(',');
+    if (n < kCols) cols[n] = trim(line.substr(0, comma));
+    ++n;
+    if (comma == std::string_view::npos) return n;
+    line.remove_prefix(comma + 1);
   }
-  cols.push_back(trim(cur));
-  return cols;
 }
 
-static bool is_header_row(const std::vector<std::string>& cols) {
-  if (cols.size() < 5) return false;
+bool is_header_row(const std::string_view (&cols)[kCols], std::size_t n) {
+  if (n < kCols) return false;
   // Very light heuristic
-  return (cols[0] == "key" || cols[0] == "Key");
+  return cols[0] == "key" || cols[0] == "Key";
 }
 
-static double to_double_safe(const std::string& s, bool& ok) {
-  try {
-    size_t idx = 0;
-    double v = std::stod(s, &idx);
-    ok = idx == s.size();
-    return v;
-  } catch(...) {
-    ok = false;
-    return 0.0;
+// Plain decimals ("-12.345") with at most 15 digits: the digits form an exact integer
+// and 10^frac is exact, so one division is correctly rounded (same as from_chars).
+bool parse_plain_decimal(std::string_view s, double& v) {
+  static constexpr double kPow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+                                      1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+  std::size_t i = 0;
+  const bool neg = !s.empty() && s[0] == '-';
+  if (neg) ++i;
+  std::uint64_t m = 0;
+  int digits = 0, frac = -1;
+  for (; i < s.size(); ++i) {
+    const char c = s[i];
+    if (c == '.' && frac < 0) { frac = 0; continue; }
+    if (c < '0' || c > '9' || ++digits > 15) return false;
+    m = m * 10 + std::uint64_t(c - '0');
+    if (frac >= 0) ++frac;
   }
+  if (digits == 0) return false;
+  v = double(m) / kPow10[frac < 0 ? 0 : frac];
+  if (neg) v = -v;
+  return true;
 }
 
-static std::optional<Track> parse_track_row(const std::vector<std::string>& cols) {
-  if (cols.size() < 5) return std::nullopt;
-  const std::string key = cols[0];
-  if (key.empty()) return std::nullopt;
-  bool ok1, ok2, ok3, ok4;
-  const double stat = to_double_safe(cols[1], ok1);
-  const double lane = to_double_safe(cols[2], ok2);
-  double sc  = to_double_safe(cols[3], ok3);
-  double vsc = to_double_safe(cols[4], ok4);
-  if (!(ok1 && ok2 && ok3 && ok4)) return std::nullopt;
+// Whole field must be a number, as with std::stod (which also takes a leading '+').
+bool parse_double(std::string_view s, double& v) {
+  if (s.size() > 1 && s[0] == '+' && s[1] != '-') s.remove_prefix(1);
+  if (parse_plain_decimal(s, v)) return true;
+  const char* end = s.data() + s.size();
+  const auto r = std::from_chars(s.data(), end, v);
+  return r.ec == std::errc{} && r.ptr == end;
+}
 
-  auto clamp01 = [](double x){ return x < 0.0 ? 0.0 : (x > 1.0 ? 1.0 : x); };
-  sc  = clamp01(sc);
-  vsc = clamp01(vsc);
+// Appends the row to out in place (no Track temporaries); false if it is invalid.
+bool parse_track_row(const std::string_view (&cols)[kCols], std::size_t n, std::vector<Track>& out) {
+  if (n < kCols) return false;
+  if (cols[0].empty()) return false;
+  double stat, lane, sc, vsc;
+  if (!(parse_double(cols[1], stat) && parse_double(cols[2], lane) &&
+        parse_double(cols[3], sc) && parse_double(cols[4], vsc))) {
+    return false;
+  }
 
-  return Track{key, stat < 0.0 ? 0.0 : stat, lane < 0.0 ? 0.0 : lane, sc, vsc};
+  auto clamp01 = [](double x){ return x < 0.0 ? 0.0 : (x > 1.0 ? 1.0 : x); };
+  Track& t = out.emplace_back();
+  t.key.assign(cols[0]);
+  t.pit_stationary_s = stat < 0.0 ? 0.0 : stat;
+  t.pit_lane_delta_s = lane < 0.0 ? 0.0 : lane;
+  t.sc_lane_factor = clamp01(sc);
+  t.vsc_lane_factor = clamp01(vsc);
+  return true;
 }
 
+} // namespace
+
 static std::vector<Track> make_catalog_builtin() {
   return {
     {"Bahrain", 2.5, 17.0, 0.45, 0.75},
@@ -84,32 +115,45 @@ std::optional<Track> track_by_key_in(const std::vector<Track>& cat, const std::s
   return *it;
 }
 
-std::vector<Track> track_catalog_from_csv_stream(std::istream& in) {
+std::vector<Track> track_catalog_from_csv(std::string_view text) {
   std::vector<Track> out;
-  std::string line;
+  // One row per line at most; counting lines is cheap next to moving Tracks on growth.
+  out.reserve(std::size_t(std::count(text.begin(), text.end(), '\n')) + 1);
+  std::string_view cols[kCols];
   bool header_consumed = false;
 
-  while (std::getline(in, line)) {
-    std::string raw = trim(line);
-    if (raw.empty()) continue;
-    if (!raw.empty() && raw[0] == '#') continue;
+  while (!text.empty()) {
+    const std::size_t nl = text.find('\n');
+    const std::string_view raw = trim(text.substr(0, nl));
+    text.remove_prefix(nl == std::string_view::npos ? text.size() : nl + 1);
+    if (raw.empty() || raw[0] == '#') continue;
 
-    auto cols = split_csv_line(raw);
+    const std::size_t n = split_csv_line(raw, cols);
 
-    if (!header_consumed && is_header_row(cols)) {
+    if (!header_consumed && is_header_row(cols, n)) {
       header_consumed = true;
       continue;
     }
 
-    if (auto row = parse_track_row(cols); row.has_value()) {
-      out.push_back(*row);
-    }
+    parse_track_row(cols, n, out);
   }
   return out;
 }
 
+std::vector<Track> track_catalog_from_csv_stream(std::istream& in) {
+  std::ostringstream buf;
+  buf << in.rdbuf();
+  return track_catalog_from_csv(buf.view());
+}
+
 std::optional<std::vector<Track>> load_track_catalog_csv(const std::string& path) {
-  std::ifstream f(path);
+  MappedFile m;
+  if (m.open(path)) {
+    return track_catalog_from_csv(
+        std::string_view(reinterpret_cast<const char*>(m.data()), m.size()));
+  }
+  // Not mappable (e.g., empty or a pipe): fall back to reading it.
+  std::ifstream f(path, std::ios::binary);
   if (!f) return std::nullopt;
   return track_catalog_from_csv_stream(f);
 }
@@ -0,0 +1,67 @@
+#include <f1tm/track_catalog.hpp>
+#include <algorithm>
+#include <bit>
+
+namespace f1tm {
+
+namespace {
+inline char fold(char c) { return (c >= 'A' && c <= 'Z') ? char(c - 'A' + 'a') : c; }
+} // namespace
+
+std::uint32_t track_key_hash(std::string_view key, bool fold_case) {
+  std::uint32_t h = 2166136261u;
+  if (fold_case) {
+    for (char c : key) h = (h ^ std::uint8_t(fold(c))) * 16777619u;
+  } else {
+    for (char c : key) h = (h ^ std::uint8_t(c)) * 16777619u;
+  }
+  return h;
+}
+
+bool track_key_equal(std::string_view a, std::string_view b, bool fold_case) {
+  if (a.size() != b.size()) return false;
+  if (!fold_case) return a == b;
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    if (fold(a[i]) != fold(b[i])) return false;
+  }
+  return true;
+}
+
+TrackCatalog::TrackCatalog(std::vector<Track> tracks, bool fold_case)
+  : tracks_(std::move(tracks)), fold_case_(fold_case) {
+  // Load factor <= 1/2 keeps probe runs short.
+  slots_.resize(std::bit_ceil(std::max<std::size_t>(2, 2 * tracks_.size())));
+  const std::size_t mask = slots_.size() - 1;
+  for (TrackId i = 0; i < tracks_.size(); ++i) {
+    const std::string_view key = tracks_[i].key;
+    const std::uint32_t h = track_key_hash(key, fold_case_);
+    std::size_t p = h & mask;
+    for (; slots_[p].id != kEmpty; p = (p + 1) & mask) {
+      if (slots_[p].hash == h && track_key_equal(tracks_[slots_[p].id].key, key, fold_case_)) break;
+    }
+    if (slots_[p].id == kEmpty) slots_[p] = Slot{h, i}; // else a duplicate; first wins
+  }
+}
+
+std::optional<TrackId> TrackCatalog::id(std::string_view key) const {
+  if (tracks_.empty()) return std::nullopt;
+  const std::size_t mask = slots_.size() - 1;
+  const std::uint32_t h = track_key_hash(key, fold_case_);
+  for (std::size_t p = h & mask; slots_[p].id != kEmpty; p = (p + 1) & mask) {
+    const Slot& sl = slots_[p];
+    if (sl.hash == h && track_key_equal(tracks_[sl.id].key, key, fold_case_)) return sl.id;
+  }
+  return std::nullopt;
+}
+
+const Track* TrackCatalog::find(std::string_view key) const {
+  const auto i = id(key);
+  return i ? &tracks_[*i] : nullptr;
+}
+
+const TrackCatalog& builtin_track_catalog() {
+  static const TrackCatalog cat(track_catalog(), true);
+  return cat;
+}
+
+} // namespace f1tm
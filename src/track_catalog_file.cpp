@@ -0,0 +1,256 @@
+#include <f1tm/track_catalog_file.hpp>
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <system_error>
+
+namespace f1tm {
+
+namespace {
+
+template <class T>
+void put(std::vector<std::uint8_t>& out, const T& v) {
+  const auto* p = reinterpret_cast<const std::uint8_t*>(&v);
+  out.insert(out.end(), p, p + sizeof(T));
+}
+
+// Size and mtime of path; false if it is not a readable regular file.
+bool stat_source(const std::string& path, CatSourceStamp& st) {
+  std::error_code ec;
+  const auto size = std::filesystem::file_size(path, ec);
+  if (ec) return false;
+  const auto mtime = std::filesystem::last_write_time(path, ec);
+  if (ec) return false;
+  st.size = size;
+  st.mtime = static_cast<std::int64_t>(mtime.time_since_epoch().count());
+  return true;
+}
+
+// Whole CSV as bytes (mapped when possible, read otherwise).
+struct SourceBytes {
+  MappedFile map;
+  std::string copy;
+  std::string_view view;
+
+  bool load(const std::string& path) {
+    if (map.open(path)) {
+      view = std::string_view(reinterpret_cast<const char*>(map.data()), map.size());
+      return true;
+    }
+    std::ifstream f(path, std::ios::binary);
+    if (!f) return false;
+    copy.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+    view = copy;
+    return true;
+  }
+};
+
+} // namespace
+
+std::uint64_t catalog_source_hash(const void* data, std::size_t size) {
+  const auto* p = static_cast<const std::uint8_t*>(data);
+  std::uint64_t h = 0x9E3779B97F4A7C15ull ^ size;
+  std::size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    std::uint64_t w;
+    std::memcpy(&w, p + i, 8);
+    h = std::rotl((h ^ w) * 0xD1B54A32D192ED03ull, 29);
+  }
+  std::uint64_t tail = 0;
+  if (i < size) std::memcpy(&tail, p + i, size - i);
+  h = std::rotl((h ^ tail) * 0xD1B54A32D192ED03ull, 29);
+  // SplitMix64 finalizer
+  h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+  h = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+  return h ^ (h >> 31);
+}
+
+bool write_compiled_track_catalog(const std::string& path, const std::vector<Track>& tracks,
+                                  const CatSourceStamp& source, bool fold_case) {
+  if (tracks.size() >= std::size_t(~std::uint32_t{0})) return false;
+  std::uint64_t key_bytes = 0;
+  for (const auto& t : tracks) key_bytes += t.key.size();
+  if (key_bytes > ~std::uint32_t{0}) return false;
+
+  // Index: same probing as TrackCatalog, first duplicate wins.
+  std::vector<CatSlot> slots(std::bit_ceil(std::max<std::size_t>(2, 2 * tracks.size())),
+                             CatSlot{0, ~std::uint32_t{0}});
+  const std::size_t mask = slots.size() - 1;
+  for (std::uint32_t i = 0; i < tracks.size(); ++i) {
+    const std::uint32_t h = track_key_hash(tracks[i].key, fold_case);
+    std::size_t p = h & mask;
+    for (; slots[p].id != ~std::uint32_t{0}; p = (p + 1) & mask) {
+      if (slots[p].hash == h && track_key_equal(tracks[slots[p].id].key, tracks[i].key, fold_case)) break;
+    }
+    if (slots[p].id == ~std::uint32_t{0}) slots[p] = CatSlot{h, i};
+  }
+
+  CatFileHeader hdr{};
+  std::memcpy(hdr.magic, kCatMagic, sizeof(hdr.magic));
+  hdr.version = kCatVersion;
+  hdr.flags = fold_case ? kCatFoldCase : 0u;
+  hdr.source = source;
+  hdr.track_count = static_cast<std::uint32_t>(tracks.size());
+  hdr.slot_count = static_cast<std::uint32_t>(slots.size());
+  hdr.key_bytes = key_bytes;
+
+  std::vector<std::uint8_t> buf;
+  buf.reserve(sizeof(hdr) + tracks.size() * sizeof(CatRecord) + slots.size() * sizeof(CatSlot) +
+              key_bytes);
+  put(buf, hdr);
+  std::uint32_t off = 0;
+  for (const auto& t : tracks) {
+    put(buf, CatRecord{off, static_cast<std::uint32_t>(t.key.size()), t.pit_stationary_s,
+                       t.pit_lane_delta_s, t.sc_lane_factor, t.vsc_lane_factor});
+    off += static_cast<std::uint32_t>(t.key.size());
+  }
+  for (const auto& s : slots) put(buf, s);
+  for (const auto& t : tracks) buf.insert(buf.end(), t.key.begin(), t.key.end());
+
+  // Each writer fills its own, exclusively created temporary file: concurrent rebuilds
+  // never write into one inode, and the last rename wins with a complete catalog.
+  std::string tmp;
+  std::FILE* f = nullptr;
+  std::random_device rd;
+  for (int attempt = 0; attempt < 16 && !f; ++attempt) {
+    const std::uint64_t r = (std::uint64_t(rd()) << 32) ^ rd();
+    char suffix[24];
+    std::snprintf(suffix, sizeof(suffix), ".%016llx.tmp", static_cast<unsigned long long>(r));
+    tmp = path + suffix;
+    f = std::fopen(tmp.c_str(), "wbx"); // fails if the name exists
+  }
+  if (!f) return false;
+  const bool written = std::fwrite(buf.data(), 1, buf.size(), f) == buf.size();
+  const bool closed = std::fclose(f) == 0;
+  std::error_code ec;
+  if (!written || !closed) {
+    std::filesystem::remove(tmp, ec);
+    return false;
+  }
+  std::filesystem::rename(tmp, path, ec);
+  if (ec) std::filesystem::remove(tmp, ec);
+  return !ec;
+}
+
+// ---- CompiledTrackCatalog ----
+
+bool CompiledTrackCatalog::open(const std::string& path) {
+  close();
+  if (!file_.open(path)) return false;
+  const std::uint8_t* d = file_.data();
+  const std::size_t n = file_.size();
+  if (n < sizeof(hdr_)) { close(); return false; }
+  std::memcpy(&hdr_, d, sizeof(hdr_));
+  const std::uint64_t need = sizeof(hdr_) + std::uint64_t(hdr_.track_count) * sizeof(CatRecord) +
+                             std::uint64_t(hdr_.slot_count) * sizeof(CatSlot) + hdr_.key_bytes;
+  if (std::memcmp(hdr_.magic, kCatMagic, sizeof(hdr_.magic)) != 0 || hdr_.version != kCatVersion ||
+      !std::has_single_bit(hdr_.slot_count) || hdr_.slot_count <= hdr_.track_count || need != n) {
+    close();
+    return false;
+  }
+  records_ = d + sizeof(hdr_);
+  slots_ = records_ + std::size_t(hdr_.track_count) * sizeof(CatRecord);
+  keys_ = reinterpret_cast<const char*>(slots_ + std::size_t(hdr_.slot_count) * sizeof(CatSlot));
+  return true;
+}
+
+void CompiledTrackCatalog::close() {
+  file_.close();
+  hdr_ = CatFileHeader{};
+  records_ = slots_ = nullptr;
+  keys_ = nullptr;
+}
+
+CatRecord CompiledTrackCatalog::record_(TrackId id) const {
+  CatRecord r;
+  std::memcpy(&r, records_ + std::size_t(id) * sizeof(CatRecord), sizeof(r));
+  return r;
+}
+
+std::string_view CompiledTrackCatalog::key(TrackId id) const {
+  const CatRecord r = record_(id);
+  // Clamp so a corrupt record cannot read past the key bytes.
+  const std::uint64_t off = std::min<std::uint64_t>(r.key_offset, hdr_.key_bytes);
+  return std::string_view(keys_ + off, std::min<std::uint64_t>(r.key_size, hdr_.key_bytes - off));
+}
+
+Track CompiledTrackCatalog::track(TrackId id) const {
+  const CatRecord r = record_(id);
+  return Track{std::string(key(id)), r.pit_stationary_s, r.pit_lane_delta_s,
+               r.sc_lane_factor, r.vsc_lane_factor};
+}
+
+std::optional<TrackId> CompiledTrackCatalog::id(std::string_view k) const {
+  if (!is_open() || hdr_.track_count == 0) return std::nullopt;
+  const std::size_t mask = hdr_.slot_count - 1;
+  const std::uint32_t h = track_key_hash(k, fold_case());
+  // Bounded probe, so a corrupt index without empty slots cannot loop forever.
+  for (std::size_t p = h & mask, left = hdr_.slot_count; left > 0; p = (p + 1) & mask, --left) {
+    CatSlot s;
+    std::memcpy(&s, slots_ + p * sizeof(CatSlot), sizeof(s));
+    if (s.id >= hdr_.track_count) return std::nullopt; // empty (or corrupt) slot
+    if (s.hash == h && track_key_equal(key(s.id), k, fold_case())) return s.id;
+  }
+  return std::nullopt;
+}
+
+std::optional<Track> CompiledTrackCatalog::find(std::string_view k) const {
+  const auto i = id(k);
+  if (!i) return std::nullopt;
+  return track(*i);
+}
+
+std::vector<Track> CompiledTrackCatalog::tracks() const {
+  std::vector<Track> out;
+  out.reserve(size());
+  for (TrackId i = 0; i < size(); ++i) out.push_back(track(i));
+  return out;
+}
+
+// ---- cache ----
+
+std::optional<CatalogCacheResult> open_track_catalog_cached(const std::string& csv_path,
+                                                            const std::string& cache_path,
+                                                            CompiledTrackCatalog& out,
+                                                            bool fold_case) {
+  CatSourceStamp st{};
+  if (!stat_source(csv_path, st)) return std::nullopt;
+
+  const bool cached = out.open(cache_path) && out.fold_case() == fold_case;
+  if (cached && out.header().source.size == st.size && out.header().source.mtime == st.mtime) {
+    return CatalogCacheResult::Hit;
+  }
+
+  SourceBytes src;
+  if (!src.load(csv_path)) { out.close(); return std::nullopt; }
+  st.size = src.view.size();
+  st.hash = catalog_source_hash(src.view.data(), src.view.size());
+
+  if (cached && out.header().source.size == st.size && out.header().source.hash == st.hash) {
+    // Touched but unchanged: rewrite the stamp in the header only. A reader racing
+    // this sees an old or new stamp; either way it is at worst a rebuild.
+    CatFileHeader hdr = out.header();
+    hdr.source = st;
+    out.close();
+    {
+      std::fstream f(cache_path, std::ios::binary | std::ios::in | std::ios::out);
+      if (!f) return std::nullopt;
+      f.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+      if (!f) return std::nullopt;
+    }
+    if (!out.open(cache_path)) return std::nullopt;
+    return CatalogCacheResult::Restamped;
+  }
+
+  const auto tracks = track_catalog_from_csv(src.view);
+  out.close(); // the rename below replaces the mapped file
+  if (!write_compiled_track_catalog(cache_path, tracks, st, fold_case)) return std::nullopt;
+  if (!out.open(cache_path)) return std::nullopt;
+  return CatalogCacheResult::Rebuilt;
+}
+
+} // namespace f1tm
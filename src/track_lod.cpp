@@ -0,0 +1,112 @@
+#include <f1tm/track_lod.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace f1tm {
+
+namespace {
+
+// Squared distance from p to segment ab.
+double dist2_to_segment(const Vec2& p, const Vec2& a, const Vec2& b) {
+  const double abx = b.x - a.x, aby = b.y - a.y;
+  const double len2 = abx*abx + aby*aby;
+  double t = (len2 > 0.0) ? ((p.x - a.x) * abx + (p.y - a.y) * aby) / len2 : 0.0;
+  t = std::clamp(t, 0.0, 1.0);
+  const double dx = a.x + abx * t - p.x, dy = a.y + aby * t - p.y;
+  return dx*dx + dy*dy;
+}
+
+} // namespace
+
+// ---- BoxTree ----
+
+void BoxTree::build(std::vector<Box2> leaves) {
+  levels_.clear();
+  if (leaves.empty()) return;
+  levels_.push_back(std::move(leaves));
+  while (levels_.back().size() > 1) {
+    const auto& below = levels_.back();
+    std::vector<Box2> up((below.size() + 1) / 2);
+    for (std::size_t i = 0; i < below.size(); ++i) up[i / 2].expand(below[i]);
+    levels_.push_back(std::move(up));
+  }
+}
+
+void BoxTree::query(const Box2& view, std::vector<Run>& runs) const {
+  runs.clear();
+  if (!levels_.empty()) query_(levels_.size() - 1, 0, view, runs);
+}
+
+void BoxTree::query_(std::size_t level, std::size_t i, const Box2& view,
+                     std::vector<Run>& runs) const {
+  if (!levels_[level][i].overlaps(view)) return;
+  if (level == 0) {
+    const auto leaf = static_cast<std::uint32_t>(i);
+    if (!runs.empty() && runs.back().second == leaf) ++runs.back().second;
+    else runs.emplace_back(leaf, leaf + 1);
+    return;
+  }
+  const auto& below = levels_[level - 1];
+  query_(level - 1, 2 * i, view, runs);
+  if (2 * i + 1 < below.size()) query_(level - 1, 2 * i + 1, view, runs);
+}
+
+// ---- decimation ----
+
+std::vector<Vec2> decimate_closed_path(const std::vector<Vec2>& pts, double tolerance_m) {
+  const std::size_t n = pts.size();
+  if (n < 4 || tolerance_m <= 0.0) return pts;
+
+  // Split the loop at the point farthest from the start, then simplify both halves.
+  std::size_t far = 1;
+  double far_d2 = -1.0;
+  for (std::size_t i = 1; i + 1 < n; ++i) {
+    const double dx = pts[i].x - pts[0].x, dy = pts[i].y - pts[0].y;
+    if (dx*dx + dy*dy > far_d2) { far_d2 = dx*dx + dy*dy; far = i; }
+  }
+
+  std::vector<char> keep(n, 0);
+  keep[0] = keep[far] = keep[n - 1] = 1;
+  const double tol2 = tolerance_m * tolerance_m;
+  std::vector<std::pair<std::size_t, std::size_t>> stack{{0, far}, {far, n - 1}};
+  while (!stack.empty()) {
+    const auto [a, b] = stack.back();
+    stack.pop_back();
+    std::size_t worst = a;
+    double worst_d2 = tol2;
+    for (std::size_t i = a + 1; i < b; ++i) {
+      const double d2 = dist2_to_segment(pts[i], pts[a], pts[b]);
+      if (d2 > worst_d2) { worst_d2 = d2; worst = i; }
+    }
+    if (worst == a) continue;
+    keep[worst] = 1;
+    stack.emplace_back(a, worst);
+    stack.emplace_back(worst, b);
+  }
+
+  std::vector<Vec2> out;
+  for (std::size_t i = 0; i < n; ++i) if (keep[i]) out.push_back(pts[i]);
+  return out;
+}
+
+// ---- TrackLod ----
+
+void TrackLod::build(const TrackPath& path) {
+  levels_.assign(1, path.points());
+  tolerance_.assign(1, 0.0);
+  double tol = kBaseToleranceM;
+  for (std::size_t k = 1; k < kMaxLevels && levels_.back().size() > 5; ++k, tol *= 2.0) {
+    auto d = decimate_closed_path(levels_.front(), tol);
+    if (d.size() >= levels_.back().size()) continue;
+    levels_.push_back(std::move(d));
+    tolerance_.push_back(tol);
+  }
+}
+
+std::size_t TrackLod::level_for(float scale_px_per_m, float max_error_px) const {
+  std::size_t k = 0;
+  while (k + 1 < levels_.size() && tolerance_[k + 1] * scale_px_per_m <= max_error_px) ++k;
+  return k;
+}
+
+} // namespace f1tm
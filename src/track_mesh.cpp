@@ -0,0 +1,220 @@
+#include <f1tm/track_mesh.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace f1tm {
+
+namespace {
+
+constexpr MeshColor kAsphalt{40, 40, 46, 255};
+constexpr MeshColor kSeam{30, 30, 34, 255};
+constexpr MeshColor kKerbRed{200, 70, 70, 255};
+constexpr MeshColor kKerbWhite{235, 235, 235, 255};
+constexpr MeshColor kCheckLight{240, 240, 240, 255};
+constexpr MeshColor kCheckDark{20, 20, 22, 255};
+constexpr MeshColor kGridBox{255, 255, 255, 30};
+
+// Shoelace sign (CCW positive, CW negative), in world coordinates.
+float polygon_area_sign(std::span<const Vec2> pts) {
+  double A = 0.0;
+  for (size_t i = 0; i + 1 < pts.size(); ++i) {
+    A += pts[i].x * pts[i+1].y - pts[i+1].x * pts[i].y;
+  }
+  return (A >= 0.0) ? +1.0f : -1.0f;
+}
+
+} // namespace
+
+void TrackMesh::tri_(P a, P b, P c, MeshColor col) {
+  // Screen space is y-down: counter-clockwise on screen has a negative cross product.
+  const float cross = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+  if (cross > 0.0f) std::swap(b, c);
+  verts_.push_back({a.x, a.y, col});
+  verts_.push_back({b.x, b.y, col});
+  verts_.push_back({c.x, c.y, col});
+}
+
+void TrackMesh::quad_(P a, P b, P c, P d, MeshColor col) {
+  tri_(a, b, c, col);
+  tri_(a, c, d, col);
+}
+
+void TrackMesh::line_(P a, P b, float thick, MeshColor col) {
+  const float dx = b.x - a.x, dy = b.y - a.y;
+  const float len = std::sqrt(dx*dx + dy*dy);
+  if (len <= 0.0f) return;
+  const float nx = -dy / len * thick * 0.5f, ny = dx / len * thick * 0.5f;
+  quad_({a.x + nx, a.y + ny}, {a.x - nx, a.y - ny}, {b.x - nx, b.y - ny}, {b.x + nx, b.y + ny}, col);
+}
+
+void TrackMesh::clear() {
+  verts_.clear();
+  for (auto& off : chunk_off_) off.clear();
+  markings_begin_ = 0;
+  markings_box_ = Box2{};
+  tree_.build({});
+}
+
+void TrackMesh::build(const TrackPath& path, const TrackMeshParams& p, std::span<const Vec2> outline) {
+  clear();
+  params_ = p;
+  const std::span<const Vec2> pts = outline.empty() ? std::span<const Vec2>(path.points()) : outline;
+  if (pts.size() < 2) return;
+
+  const float s = p.scale_px_per_m;
+  const float half_w_px = 0.5f * p.width_m * s;
+  const std::size_t n = pts.size(); // closed: pts[n-1] == pts[0]
+  std::vector<P> px(n);
+  for (std::size_t i = 0; i < n; ++i) px[i] = {float(pts[i].x * s), float(-pts[i].y * s)};
+
+  // Unit normals per segment in pixel space; degenerate segments reuse the previous one.
+  const std::size_t segs = n - 1;
+  std::vector<P> nrm(segs, P{0.0f, 0.0f});
+  P last{0.0f, -1.0f};
+  for (std::size_t i = 0; i < segs; ++i) {
+    const float dx = px[i+1].x - px[i].x, dy = px[i+1].y - px[i].y;
+    const float len = std::sqrt(dx*dx + dy*dy);
+    if (len > 0.0f) last = {-dy / len, dx / len};
+    nrm[i] = last;
+  }
+
+  // Records where each chunk of segments starts in a layer.
+  auto mark = [&](Layer layer, std::size_t seg) {
+    if (seg % kChunkSegs == 0) chunk_off_[layer].push_back(static_cast<std::uint32_t>(verts_.size()));
+  };
+  auto close_layer = [&](Layer layer) {
+    chunk_off_[layer].push_back(static_cast<std::uint32_t>(verts_.size()));
+  };
+
+  // Asphalt: one mitred strip around the loop (no gaps or overlaps at corners).
+  verts_.reserve(segs * 12);
+  auto edge = [&](std::size_t i, float side) {
+    const P a = nrm[(i + segs - 1) % segs], b = nrm[i % segs];
+    P m{a.x + b.x, a.y + b.y};
+    const float ml = std::sqrt(m.x*m.x + m.y*m.y);
+    if (ml < 1e-6f) m = b; else m = {m.x / ml, m.y / ml};
+    // Miter length half_w / cos(theta/2), capped at 2 * half_w for hairpins.
+    const float l = half_w_px / std::max(0.5f, m.x * b.x + m.y * b.y);
+    const P c = px[i % segs];
+    return P{c.x + side * m.x * l, c.y + side * m.y * l};
+  };
+  P l0 = edge(0, 1.0f), r0 = edge(0, -1.0f);
+  for (std::size_t i = 0; i < segs; ++i) {
+    mark(kAsphaltLayer, i);
+    const P l1 = edge(i + 1, 1.0f), r1 = edge(i + 1, -1.0f);
+    quad_(l0, r0, r1, l1, kAsphalt);
+    l0 = l1;
+    r0 = r1;
+  }
+  close_layer(kAsphaltLayer);
+
+  // Centre seam
+  for (std::size_t i = 1; i < n; ++i) {
+    mark(kSeamLayer, i - 1);
+    line_(px[i-1], px[i], 2.0f, kSeam);
+  }
+  close_layer(kSeamLayer);
+
+  // Kerbs along inner edge (alternate red/white short dashes)
+  const float orient = polygon_area_sign(pts); // +1 for CCW
+  const float kerb_dash_px = 14.0f;
+  const float kerb_thick_px = 6.0f;
+  bool red = true;
+  for (std::size_t i = 1; i < n; ++i) {
+    mark(kKerbLayer, i - 1);
+    const P a = px[i-1], b = px[i];
+    const float abx = b.x - a.x, aby = b.y - a.y;
+    const float len = std::sqrt(abx*abx + aby*aby);
+    if (len < 1.0f) continue;
+    const P t{abx / len, aby / len};
+    const P nn{-t.y * orient, t.x * orient}; // inner edge
+    const float off = half_w_px - kerb_thick_px * 0.5f;
+    const P inner_a{a.x + nn.x * off, a.y + nn.y * off};
+    float consumed = 0.0f;
+    while (consumed < len) {
+      const float dash = std::min(kerb_dash_px, len - consumed);
+      const P p0{inner_a.x + t.x * consumed, inner_a.y + t.y * consumed};
+      const P p1{inner_a.x + t.x * (consumed + dash), inner_a.y + t.y * (consumed + dash)};
+      line_(p0, p1, kerb_thick_px, red ? kKerbRed : kKerbWhite);
+      consumed += dash;
+      red = !red;
+    }
+  }
+  close_layer(kKerbLayer);
+
+  // Chunk bounds over all chunked layers
+  const std::size_t chunks = chunk_off_[kAsphaltLayer].size() - 1;
+  std::vector<Box2> boxes(chunks);
+  for (int layer = 0; layer < kLayers; ++layer) {
+    for (std::size_t c = 0; c < chunks; ++c) {
+      for (std::uint32_t v = chunk_off_[layer][c]; v < chunk_off_[layer][c + 1]; ++v) {
+        boxes[c].expand(verts_[v].x, verts_[v].y);
+      }
+    }
+  }
+  tree_.build(std::move(boxes));
+  markings_begin_ = static_cast<std::uint32_t>(verts_.size());
+
+  // Start/finish checker (at segment 0->1)
+  {
+    const P a = px[0], b = px[1];
+    const float abx = b.x - a.x, aby = b.y - a.y;
+    const float len = std::sqrt(abx*abx + aby*aby);
+    if (len > 0.1f) {
+      const P t{abx / len, aby / len};
+      const P nn{-t.y, t.x};
+      const int squares = 10;
+      for (int i = 0; i < squares; ++i) {
+        const float off = -half_w_px + (2.0f*half_w_px) * ((i + 0.5f) / squares);
+        const P p0{a.x + nn.x * off, a.y + nn.y * off};
+        const P p1{p0.x + t.x * 8.0f, p0.y + t.y * 8.0f};
+        line_(p0, p1, 6.0f, (i % 2 == 0) ? kCheckLight : kCheckDark);
+      }
+    }
+  }
+
+  // Grid boxes for the car count
+  const int rows = (p.grid_cars + 1) / 2;
+  const float row_gap_m   = 9.0f;
+  const float lane_gap_m  = 3.0f;   // off-pole further back
+  const float box_len_m   = 4.0f;   // along tangent
+  const float lane_off_m  = p.width_m * 0.25f; // lateral offset from centerline
+  const float box_w = p.width_m * 0.7f * s;    // across track
+  const float box_h = box_len_m * s;           // along track
+  for (int row = 0; row < rows; ++row) {
+    for (int lane = 0; lane < 2; ++lane) {
+      if (row * 2 + lane >= p.grid_cars) break;
+      const float back_m = row * row_gap_m + (lane == 1 ? lane_gap_m : 0.0f);
+      const double off = (lane == 0 ? -lane_off_m : lane_off_m);
+      // Boxes follow the path (and its normal) behind the line, same as the cars' grid slots.
+      double bx, by, heading;
+      path.sample_pose(-double(back_m), off, bx, by, heading);
+      const P c{float(bx * s), float(-by * s)};
+      // Screen rotation of heading + 90 deg (y down), centred box.
+      const float rot = float(heading + kPI * 0.5);
+      const float cs = std::cos(rot), sn = std::sin(rot);
+      auto corner = [&](float dx, float dy) {
+        return P{c.x + dx*cs - dy*sn, c.y + dx*sn + dy*cs};
+      };
+      quad_(corner(-box_w*0.5f, -box_h*0.5f), corner(-box_w*0.5f, box_h*0.5f),
+            corner(box_w*0.5f, box_h*0.5f), corner(box_w*0.5f, -box_h*0.5f), kGridBox);
+    }
+  }
+  for (std::size_t v = markings_begin_; v < verts_.size(); ++v) markings_box_.expand(verts_[v].x, verts_[v].y);
+}
+
+void TrackMesh::visible(const Box2& view, std::vector<VertexRange>& out) const {
+  out.clear();
+  tree_.query(view, runs_);
+  for (int layer = 0; layer < kLayers; ++layer) {
+    const auto& off = chunk_off_[layer];
+    for (const auto& [first, last] : runs_) {
+      if (off[first] != off[last]) out.push_back({off[first], off[last]});
+    }
+  }
+  if (markings_box_.overlaps(view)) {
+    out.push_back({markings_begin_, static_cast<std::uint32_t>(verts_.size())});
+  }
+}
+
+} // namespace f1tm
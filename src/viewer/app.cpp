@@ -1,9 +1,10 @@
 #include <raylib.h>
+#include <rlgl.h>
 #include <cmath>
+#include <span>
 #include <vector>
 #include <string>
 #include <algorithm>
-#include <unordered_map>
 #include <cstdio>
 #include <fstream>
 #include <sstream>
@@ -12,15 +13,15 @@
 #include <f1tm/viewer/app.hpp>
 #include <f1tm/sim_runner.hpp>
 #include <f1tm/snap_buffer.hpp>
+#include <f1tm/replay.hpp>
 #include <f1tm/track_geom.hpp> // kPI, TrackPath
+#include <f1tm/car_batch.hpp>
+#include <f1tm/race_order.hpp>
 
 namespace f1tm {
 
 namespace {
 
-// radians -> degrees using our kPI constant
-static constexpr double kRadToDeg = 180.0 / kPI;
-
 static const char* warpLabel(double w) {
   if (w == 0.0)  return "Paused";
   if (w == 0.25) return "0.25x";
@@ -31,61 +32,27 @@ static const char* warpLabel(double w) {
   return "custom";
 }
 
-// High-contrast palette; assigned per CarId (stable during session).
+// Stable per-CarId colors, shared by the car batch and the dashboard.
+static CarColorTable g_car_colors;
+
 static Color colorFor(CarId id) {
-  static const Color PAL[] = {
-    {231, 76, 60, 255},   // red
-    {52, 152, 219, 255},  // blue
-    {46, 204, 113, 255},  // green
-    {241, 196, 15, 255},  // yellow
-    {155, 89, 182, 255},  // purple
-    {26, 188, 156, 255},  // teal
-    {230, 126, 34, 255},  // orange
-    {236, 112, 99, 255},  // salmon
-    {39, 174, 96, 255},   // dark green
-    {52, 73, 94, 255},    // slate
-    {127, 140, 141, 255}, // gray
-    {241, 90, 36, 255},   // orange-red
-    {0, 152, 117, 255},   // sea green
-    {91, 44, 111, 255},   // deep purple
-    {142, 68, 173, 255},  // amethyst
-    {33, 97, 140, 255},   // steel blue
-  };
-  static std::unordered_map<CarId, int> idx;
-  auto it = idx.find(id);
-  if (it == idx.end()) {
-    int assigned = static_cast<int>(idx.size()) % static_cast<int>(sizeof(PAL)/sizeof(PAL[0]));
-    it = idx.emplace(id, assigned).first;
-  }
-  return PAL[it->second];
+  const MeshColor c = g_car_colors.color(id);
+  return Color{c.r, c.g, c.b, c.a};
 }
 
-static float length2f(Vector2 v) { return std::sqrt(v.x*v.x + v.y*v.y); }
-
-// Shoelace sign (CCW positive, CW negative)
-static float polygon_area_sign(const std::vector<Vec2>& pts) {
-  double A = 0.0;
-  for (size_t i = 0; i + 1 < pts.size(); ++i) {
-    A += pts[i].x * pts[i+1].y - pts[i+1].x * pts[i].y;
+// Submits a triangle list offset by (ox, oy), in chunks the render batch can hold.
+static void draw_triangles(std::span<const MeshVertex> v, float ox, float oy) {
+  const std::size_t kChunk = 3 * 1024; // whole triangles per batch check
+  for (std::size_t i = 0; i < v.size(); i += kChunk) {
+    const std::size_t end = std::min(v.size(), i + kChunk);
+    rlCheckRenderBatchLimit(int(end - i));
+    rlBegin(RL_TRIANGLES);
+    for (std::size_t k = i; k < end; ++k) {
+      rlColor4ub(v[k].c.r, v[k].c.g, v[k].c.b, v[k].c.a);
+      rlVertex2f(v[k].x + ox, v[k].y + oy);
+    }
+    rlEnd();
   }
-  return (A >= 0.0) ? +1.0f : -1.0f;
-}
-
-// Time formatting helpers
-static void fmt_time(double s, char* out, int cap) {
-  if (cap <= 0 || out == nullptr) return;
-  if (s < 0.0 || !std::isfinite(s)) { std::snprintf(out, (size_t)cap, "%s", "--"); return; }
-  int minutes = (int)(s / 60.0);
-  double rem  = s - minutes * 60.0;
-  int secs    = (int)rem;
-  int ms      = (int)((rem - secs) * 1000.0 + 0.5);
-  if (minutes > 0) std::snprintf(out, (size_t)cap, "%d:%02d.%03d", minutes, secs, ms);
-  else             std::snprintf(out, (size_t)cap, "%d.%03d", secs, ms);
-}
-static void fmt_gap(double s, char* out, int cap) {
-  if (cap <= 0 || out == nullptr) return;
-  if (s < 0.0) { std::snprintf(out, (size_t)cap, "%s", "--"); return; }
-  std::snprintf(out, (size_t)cap, "+%.3f", s);
 }
 
 // --- HUD layout (keep in sync with draw_hud_) ---
@@ -108,6 +75,7 @@ struct RaceState {
   double finish_sim_time{0.0};
   std::string saved_json_path;
   std::string saved_csv_path;
+  std::string saved_summary_path;
   // snapshot of order at finish
   std::vector<CarPose> final_order;
 };
@@ -197,24 +165,48 @@ static void save_results_(const std::vector<CarPose>& ordered,
   }
 }
 
+// Per-car lap/sector statistics from the server's RaceSummary.
+static void save_summary_(const RaceSummary& summary, std::string& out_path) {
+  out_path = "race_summary_" + timestamp_yyyyMMdd_HHmmss_() + ".json";
+  std::ofstream jf(out_path, std::ios::binary);
+  auto stats = [&](const TimeSummary& t) {
+    jf << "{\"n\":" << (unsigned long long)t.count
+       << ",\"mean\":" << t.mean << ",\"stddev\":" << t.stddev
+       << ",\"min\":" << t.min << ",\"max\":" << t.max
+       << ",\"p50\":" << t.p50 << ",\"p90\":" << t.p90 << "}";
+  };
+  jf << "{\n";
+  jf << "  \"finish_time\": " << summary.finish_time() << ",\n";
+  jf << "  \"entries\": [\n";
+  const auto& cars = summary.cars();
+  for (size_t i = 0; i < cars.size(); ++i) {
+    const auto& c = cars[i];
+    jf << "    {\"pos\":" << (i+1)
+       << ",\"id\":" << (unsigned)c.id
+       << ",\"laps\":" << (unsigned long long)c.laps
+       << ",\"total_time\":" << c.total_time
+       << ",\"lap\":";
+    stats(c.lap);
+    for (int k = 0; k < 3; ++k) {
+      jf << ",\"s" << (k+1) << "\":";
+      stats(c.sector[k]);
+    }
+    jf << "}" << (i+1<cars.size()? ",":"") << "\n";
+  }
+  jf << "  ]\n}\n";
+}
+
 // Called every frame; decides finish conditions and persists results exactly once.
-static void race_update_(const SimSnapshot& draw, const SimRunner& sim) {
+static void race_update_(const SimSnapshot& draw, const RaceOrder& order, SimRunner& sim) {
   if (!g_race_state.active || g_race_state.finished) return;
 
   const double C = sim.track_path().length();
-  // Find leader and compute finish condition
-  auto cars = draw.cars;
-  if (cars.empty()) return;
-
-  std::sort(cars.begin(), cars.end(), [](const CarPose& a, const CarPose& b){
-    if (a.lap != b.lap) return a.lap > b.lap;
-    return a.s > b.s;
-  });
+  if (order.empty()) return;
 
   bool should_finish = false;
   if (g_race_cfg.mode == RaceMode::Laps) {
     // Finish when leader reaches target laps
-    if ((int)cars.front().lap >= g_race_cfg.target_laps) should_finish = true;
+    if ((int)order.leader().lap >= g_race_cfg.target_laps) should_finish = true;
   } else {
     if (draw.sim_time >= g_race_cfg.target_seconds) should_finish = true;
   }
@@ -222,7 +214,7 @@ static void race_update_(const SimSnapshot& draw, const SimRunner& sim) {
   if (should_finish) {
     g_race_state.finished = true;
     g_race_state.finish_sim_time = draw.sim_time;
-    g_race_state.final_order = cars;
+    g_race_state.final_order = order.poses();
     save_results_(g_race_state.final_order,
                   g_race_state.finish_sim_time,
                   g_race_cfg,
@@ -230,6 +222,7 @@ static void race_update_(const SimSnapshot& draw, const SimRunner& sim) {
                   sim.preset_name(),
                   g_race_state.saved_json_path,
                   g_race_state.saved_csv_path);
+    sim.request_summary(); // statistics arrive via summary_buffer()
   }
 }
 
@@ -257,7 +250,7 @@ static void race_input_() {
 
 // ---- ViewerApp ----
 
-ViewerApp::ViewerApp(SimRunner& sim) : sim_(sim) {}
+ViewerApp::ViewerApp(SimRunner& sim, ReplaySource* replay) : sim_(sim), replay_(replay) {}
 
 ViewerApp::Vec2f ViewerApp::worldToScreen_(double x, double y, float scale) const {
   const float cx = GetScreenWidth()  * 0.5f + pan_x_m_ * scale;
@@ -271,8 +264,15 @@ int ViewerApp::run() {
   SetTargetFPS(144);
 
   while (!WindowShouldClose()) {
-    process_input_();
-    pump_snapshots_();
+    ScopedStageTimer frame(profiler_, kStageFrame); // includes the vsync wait in EndDrawing
+    {
+      ScopedStageTimer t(profiler_, kStageInput);
+      process_input_();
+    }
+    {
+      ScopedStageTimer t(profiler_, kStagePump);
+      pump_snapshots_();
+    }
     render_frame_();
   }
 
@@ -280,17 +280,67 @@ int ViewerApp::run() {
   return 0;
 }
 
+void ViewerApp::process_replay_input_() {
+  // Playback controls mirror the live warp keys; , and . seek by 10 s, Home rewinds.
+  if (IsKeyPressed(KEY_SPACE)) replay_->set_paused(!replay_->paused());
+  if (IsKeyPressed(KEY_ONE))   replay_->set_warp(0.25);
+  if (IsKeyPressed(KEY_TWO))   replay_->set_warp(0.5);
+  if (IsKeyPressed(KEY_THREE)) replay_->set_warp(1.0);
+  if (IsKeyPressed(KEY_FOUR))  replay_->set_warp(2.0);
+  if (IsKeyPressed(KEY_FIVE))  replay_->set_warp(4.0);
+
+  double seek_to = -1.0;
+  if (IsKeyPressed(KEY_COMMA))  seek_to = std::max(0.0, replay_->time() - 10.0);
+  if (IsKeyPressed(KEY_PERIOD)) seek_to = replay_->time() + 10.0;
+  if (IsKeyPressed(KEY_HOME))   seek_to = 0.0;
+  if (seek_to >= 0.0) {
+    replay_->seek(seek_to);
+    ibuf_ = InterpBuffer{}; // history is from the old position
+  }
+}
+
 void ViewerApp::process_input_() {
-  // Time warp controls
-  if (IsKeyPressed(KEY_SPACE)) {
-    double cur = sim_.time_scale.load();
-    sim_.time_scale.store(cur == 0.0 ? 1.0 : 0.0);
+  if (replay_) {
+    process_replay_input_();
+  } else {
+    // Time warp controls
+    if (IsKeyPressed(KEY_SPACE)) {
+      double cur = sim_.time_scale.load();
+      sim_.time_scale.store(cur == 0.0 ? 1.0 : 0.0);
+    }
+    if (IsKeyPressed(KEY_ONE))   sim_.time_scale.store(0.25);
+    if (IsKeyPressed(KEY_TWO))   sim_.time_scale.store(0.5);
+    if (IsKeyPressed(KEY_THREE)) sim_.time_scale.store(1.0);
+    if (IsKeyPressed(KEY_FOUR))  sim_.time_scale.store(2.0);
+    if (IsKeyPressed(KEY_FIVE))  sim_.time_scale.store(4.0);
+
+    // Race control, field, recording and track keys drive the live sim only; in a
+    // replay they would change the hidden sim (and the track drawn under the replay).
+    race_input_();
+
+    // Toggle N cars: cycle 1 -> 2 -> 4 -> 8 -> 1
+    if (IsKeyPressed(KEY_N)) {
+      static const int N_CYCLE[4] = {1,2,4,8};
+      n_cycle_idx_ = (n_cycle_idx_ + 1) % 4;
+      sim_.request_reseed(N_CYCLE[n_cycle_idx_]);
+      // reset race because field changed
+      g_race_state = RaceState{};
+    }
+
+    // Toggle race recording (.f1rec, written on the recorder thread)
+    if (IsKeyPressed(KEY_L)) {
+      sim_.request_recording(!sim_.recording());
+    }
+
+    // Toggle Track Preset
+    if (IsKeyPressed(KEY_T)) {
+      auto p = sim_.current_preset();
+      int next = (static_cast<int>(p) + 1) % static_cast<int>(TrackPreset::Count);
+      sim_.request_track_preset(static_cast<TrackPreset>(next));
+      // reset race because track changed
+      g_race_state = RaceState{};
+    }
   }
-  if (IsKeyPressed(KEY_ONE))   sim_.time_scale.store(0.25);
-  if (IsKeyPressed(KEY_TWO))   sim_.time_scale.store(0.5);
-  if (IsKeyPressed(KEY_THREE)) sim_.time_scale.store(1.0);
-  if (IsKeyPressed(KEY_FOUR))  sim_.time_scale.store(2.0);
-  if (IsKeyPressed(KEY_FIVE))  sim_.time_scale.store(4.0);
 
   // Zoom
   if (IsKeyDown(KEY_W) || IsKeyDown(KEY_KP_ADD))      scale_px_per_m_ *= 1.01f;
@@ -304,180 +354,107 @@ void ViewerApp::process_input_() {
   if (IsKeyDown(KEY_DOWN))  pan_y_m_ -= pan_step;
   if (IsKeyPressed(KEY_C))  { pan_x_m_ = 0.0f; pan_y_m_ = -100.0f; } // default offset (track lower)
 
-  // Race control hotkeys
-  race_input_();
-
-  // Toggle N cars: cycle 1 -> 2 -> 4 -> 8 -> 1
-  if (IsKeyPressed(KEY_N)) {
-    static const int N_CYCLE[4] = {1,2,4,8};
-    n_cycle_idx_ = (n_cycle_idx_ + 1) % 4;
-    sim_.request_reseed(N_CYCLE[n_cycle_idx_]);
-    // reset race because field changed
-    g_race_state = RaceState{};
-  }
-
-  // Toggle Track Preset
-  if (IsKeyPressed(KEY_T)) {
-    auto p = sim_.current_preset();
-    int next = (static_cast<int>(p) + 1) % static_cast<int>(TrackPreset::Count);
-    sim_.request_track_preset(static_cast<TrackPreset>(next));
-    // reset race because track changed
-    g_race_state = RaceState{};
+  // Toggle the profiler overlay; opening it starts fresh histograms
+  if (IsKeyPressed(KEY_F3)) {
+    show_profiler_ = !show_profiler_;
+    if (show_profiler_) {
+      profiler_.reset();
+      sim_.profiler().reset();
+    }
   }
 }
 
 void ViewerApp::pump_snapshots_() {
+  if (replay_) {
+    // Playback clock advances with wall time; the source yields at most one new frame.
+    replay_->advance(GetFrameTime());
+    if (replay_->try_consume_latest(cursor_, last_snap_)) ibuf_.push(last_snap_);
+    return;
+  }
+
   // Pull any new snapshots; store into interpolation buffer
   auto& buf = sim_.buffer();
   while (buf.try_consume_latest(cursor_, last_snap_)) {
     ibuf_.push(last_snap_);
   }
+
+  RaceSummary summary;
+  if (sim_.summary_buffer().try_consume_latest(summary_cursor_, summary) && g_race_state.finished) {
+    save_summary_(summary, g_race_state.saved_summary_path);
+  }
 }
 
 void ViewerApp::render_frame_() {
   // Resolve draw snapshot (slightly behind latest for interpolation)
   SimSnapshot draw = last_snap_;
   const double target = ibuf_.latest_time() - interp_delay_;
-  (void)ibuf_.sample(target, draw);
+  {
+    ScopedStageTimer t(profiler_, kStageInterp);
+    (void)ibuf_.sample(target, draw);
+  }
+
+  race_order_.update(draw.cars);
 
-  // Update race state & save results when finishing
-  race_update_(draw, sim_);
+  // Update race state & save results when finishing (live races only)
+  if (!replay_) race_update_(draw, race_order_, sim_);
 
   BeginDrawing();
   // Grass background
   ClearBackground(Color{30, 60, 30, 255});
 
-  draw_track_(scale_px_per_m_);
-
-  // Draw each car
-  for (const auto& car : draw.cars) {
-    Vector2 pos = { worldToScreen_(car.x, car.y, scale_px_per_m_).x,
-                    worldToScreen_(car.x, car.y, scale_px_per_m_).y };
-    float len = 12.0f, wid = 6.0f;
-    float c = std::cos(float(car.heading_rad)), s = std::sin(float(car.heading_rad));
-    Vector2 nose  = { pos.x + c*len,          pos.y - s*len };
-    Vector2 tailL = { pos.x - c*len + s*wid,  pos.y + s*len + c*wid };
-    Vector2 tailR = { pos.x - c*len - s*wid,  pos.y + s*len - c*wid };
-    DrawTriangle(nose, tailL, tailR, colorFor(car.id));
-    DrawCircleV(pos, 3.0f, colorFor(car.id)); // colored marker at center
+  {
+    ScopedStageTimer t(profiler_, kStageTrack);
+    draw_track_(scale_px_per_m_);
+  }
+
+  // Draw all on-screen cars as one triangle list
+  {
+    ScopedStageTimer t(profiler_, kStageCars);
+    const auto o = worldToScreen_(0.0, 0.0, scale_px_per_m_);
+    const Box2 screen{0.0f, 0.0f, float(GetScreenWidth()), float(GetScreenHeight())};
+    car_batch_.build(draw.cars, scale_px_per_m_, o.x, o.y, g_car_colors, &screen);
+    draw_triangles(car_batch_.vertices(), 0.0f, 0.0f);
   }
 
-  draw_dashboard_(draw);
+  {
+    ScopedStageTimer t(profiler_, kStageDashboard);
+    draw_dashboard_();
+  }
   draw_hud_(draw);
+  if (show_profiler_) draw_profiler_();
   EndDrawing();
 }
 
 void ViewerApp::draw_track_(float scale_px_per_m) {
   const auto& path = sim_.track_path();
-  const auto& pts = path.points();
-  if (pts.size() < 2) return;
-
-  const float width_m = 12.0f;
-  const float half_w_px = 0.5f * width_m * scale_px_per_m;
-
-  // Asphalt ribbon (thick segment lines)
-  for (std::size_t i = 1; i < pts.size(); ++i) {
-    auto a = worldToScreen_(pts[i-1].x, pts[i-1].y, scale_px_per_m);
-    auto b = worldToScreen_(pts[i].x,   pts[i].y,   scale_px_per_m);
-    DrawLineEx({a.x,a.y}, {b.x,b.y}, half_w_px*2.0f, Color{40,40,46,255});
-  }
-  // Edges
-  for (std::size_t i = 1; i < pts.size(); ++i) {
-    auto a = worldToScreen_(pts[i-1].x, pts[i-1].y, scale_px_per_m);
-    auto b = worldToScreen_(pts[i].x,   pts[i].y,   scale_px_per_m);
-    DrawLineEx({a.x,a.y}, {b.x,b.y}, 2.0f, Color{30,30,34,255});
-  }
-
-  // Kerbs along inner edge (alternate red/white short dashes)
-  const float orient = polygon_area_sign(pts); // +1 for CCW
-  const float kerb_dash_px = 14.0f;
-  const float kerb_thick_px = 6.0f;
-  bool red = true;
-  for (std::size_t i = 1; i < pts.size(); ++i) {
-    auto a = worldToScreen_(pts[i-1].x, pts[i-1].y, scale_px_per_m);
-    auto b = worldToScreen_(pts[i].x,   pts[i].y,   scale_px_per_m);
-    Vector2 ab = { b.x - a.x, b.y - a.y };
-    const float len = length2f(ab);
-    if (len < 1.0f) continue;
-    // tangent + normal
-    Vector2 t = { ab.x / len, ab.y / len };
-    Vector2 n = { -t.y * orient, t.x * orient }; // inner edge
-    const Vector2 inner_a = { a.x + n.x * (half_w_px - kerb_thick_px*0.5f),
-                              a.y + n.y * (half_w_px - kerb_thick_px*0.5f) };
-    float consumed = 0.0f;
-    while (consumed < len) {
-      float dash = std::min(kerb_dash_px, len - consumed);
-      Vector2 p0 = { inner_a.x + t.x * consumed,           inner_a.y + t.y * consumed };
-      Vector2 p1 = { inner_a.x + t.x * (consumed + dash),  inner_a.y + t.y * (consumed + dash) };
-      DrawLineEx(p0, p1, kerb_thick_px, red ? Color{200,70,70,255} : Color{235,235,235,255});
-      consumed += dash;
-      red = !red;
+  const TrackMeshKey key{static_cast<int>(sim_.current_preset()), path.points().size(), path.length(),
+                         scale_px_per_m, (int)last_snap_.cars.size()};
+  if (key != track_mesh_key_) {
+    if (key.preset != track_mesh_key_.preset || key.points != track_mesh_key_.points ||
+        key.length != track_mesh_key_.length) {
+      track_lod_.build(path);
     }
+    TrackMeshParams p;
+    p.scale_px_per_m = scale_px_per_m;
+    p.grid_cars = key.grid_cars;
+    track_mesh_.build(path, p, track_lod_.points_for(scale_px_per_m));
+    track_mesh_key_ = key;
   }
 
-  // Start/finish checker (at segment 0->1)
-  if (pts.size() >= 2) {
-    auto a = worldToScreen_(pts[0].x, pts[0].y, scale_px_per_m);
-    auto b = worldToScreen_(pts[1].x, pts[1].y, scale_px_per_m);
-    Vector2 ab = { b.x - a.x, b.y - a.y };
-    const float len = length2f(ab);
-    if (len > 0.1f) {
-      Vector2 t = { ab.x / len, ab.y / len };
-      Vector2 n = { -t.y, t.x };
-      const int squares = 10;
-      for (int i = 0; i < squares; ++i) {
-        Color c = (i % 2 == 0) ? Color{240,240,240,255} : Color{20,20,22,255};
-        float off = -half_w_px + (2.0f*half_w_px) * ((i + 0.5f) / squares);
-        Vector2 p0 = { a.x + n.x * off, a.y + n.y * off };
-        Vector2 p1 = { p0.x + t.x * 8.0f, p0.y + t.y * 8.0f };
-        DrawLineEx(p0, p1, 6.0f, c);
-      }
-    }
-  }
-
-  // Grid boxes for current car count (from latest snapshot)
-  int car_count = (int)last_snap_.cars.size();
-  const int rows = (car_count + 1) / 2;
-  const float row_gap_m   = 9.0f;
-  const float lane_gap_m  = 3.0f;   // off-pole further back
-  const float box_len_m   = 4.0f;   // along tangent
-  const float lane_off_m  = width_m * 0.25f; // lateral offset from centerline
-
-  if (pts.size() >= 2) {
-    // derive tangent at s=0 from pts[0]->pts[1]
-    const double dx = (pts[1].x - pts[0].x), dy = (pts[1].y - pts[0].y);
-    const double t = std::atan2(dy, dx);
-    const double cos_t = std::cos(t), sin_t = std::sin(t);
-    for (int row = 0; row < rows; ++row) {
-      for (int lane = 0; lane < 2; ++lane) {
-        const int idx = row * 2 + lane;
-        if (idx >= car_count) break;
-        const float back_m = row * row_gap_m + (lane == 1 ? lane_gap_m : 0.0f);
-        const double px = pts[0].x - cos_t * back_m;
-        const double py = pts[0].y - sin_t * back_m;
-        const double nx = -sin_t, ny =  cos_t;
-        const double off = (lane == 0 ? -lane_off_m : lane_off_m);
-        auto boxc = worldToScreen_(px + nx*off, py + ny*off, scale_px_per_m);
-        const float angle_deg = float((t + kPI * 0.5) * kRadToDeg);
-        Rectangle box {
-          boxc.x,
-          boxc.y,
-          width_m * 0.7f * scale_px_per_m,   // across track
-          box_len_m * scale_px_per_m         // along track
-        };
-        DrawRectanglePro(box, {box.width*0.5f, box.height*0.5f}, angle_deg, Color{255,255,255,30});
-      }
-    }
+  // Mesh is origin-relative: only the screen centre and pan move it. Draw the chunks
+  // that overlap the screen.
+  const auto o = worldToScreen_(0.0, 0.0, scale_px_per_m);
+  const Box2 view{-o.x, -o.y, GetScreenWidth() - o.x, GetScreenHeight() - o.y};
+  track_mesh_.visible(view, track_ranges_);
+  const auto& v = track_mesh_.vertices();
+  for (const auto& r : track_ranges_) {
+    draw_triangles(std::span<const MeshVertex>(v).subspan(r.begin, r.end - r.begin), o.x, o.y);
   }
 }
 
-void ViewerApp::draw_dashboard_(const SimSnapshot& draw) {
-  // Sorted by race position (lap desc, s desc)
-  std::vector<CarPose> cars = draw.cars;
-  std::sort(cars.begin(), cars.end(), [](const CarPose& a, const CarPose& b){
-    if (a.lap != b.lap) return a.lap > b.lap;
-    return a.s > b.s;
-  });
+void ViewerApp::draw_dashboard_() {
+  // Rows in race position (lap desc, s desc), text cached by race_order_
+  const RaceOrder& cars = race_order_;
 
   const int row_h = 18;
   const int pad   = 8;
@@ -515,16 +492,8 @@ void ViewerApp::draw_dashboard_(const SimSnapshot& draw) {
   DrawText("S2",   X_S2,   y0 + pad - 2, 16, hdr);
   DrawText("S3",   X_S3,   y0 + pad - 2, 16, hdr);
 
-  // --- Sector highlight pre-pass: find current lap-best (min) among cars ---
-  double s1_min = -1.0, s2_min = -1.0, s3_min = -1.0;
-  auto upd_min = [](double last, double& acc){
-    if (last >= 0.0) acc = (acc < 0.0) ? last : std::min(acc, last);
-  };
-  for (const auto& c : cars) {
-    upd_min(c.s1_last, s1_min);
-    upd_min(c.s2_last, s2_min);
-    upd_min(c.s3_last, s3_min);
-  }
+  // Sector highlight: current lap-best (min) among cars
+  const double s1_min = cars.sector_min(1), s2_min = cars.sector_min(2), s3_min = cars.sector_min(3);
 
   // Sector cell colors
   const Color colDefault = Color{200,200,210,255};
@@ -540,38 +509,28 @@ void ViewerApp::draw_dashboard_(const SimSnapshot& draw) {
 
   // Rows
   int y = y0 + pad + row_h + 2;
-  int pos = 1;
-  char buf_last[32], buf_best[32], buf_id[16], buf_lap[16];
-  char buf_gap[32], buf_s1[32], buf_s2[32], buf_s3[32];
-
-  for (const auto& c : cars) {
-    fmt_time(c.last_lap_time, buf_last, sizeof(buf_last));
-    fmt_time(c.best_lap_time, buf_best, sizeof(buf_best));
-    fmt_gap (c.gap_to_leader_s, buf_gap, sizeof(buf_gap));
-    fmt_time(c.s1_last, buf_s1, sizeof(buf_s1));
-    fmt_time(c.s2_last, buf_s2, sizeof(buf_s2));
-    fmt_time(c.s3_last, buf_s3, sizeof(buf_s3));
-    std::snprintf(buf_id,  sizeof(buf_id),  "%u", (unsigned)c.id);
-    std::snprintf(buf_lap, sizeof(buf_lap), "%llu", (unsigned long long)c.lap);
+  for (std::size_t i = 0; i < cars.size(); ++i) {
+    const RaceOrderRow& row = cars[i];
+    const CarPose& c = row.pose;
+    const int pos = int(i) + 1;
 
     Color posCol = (pos==1) ? Color{255,215,0,255}
                   : (pos==2) ? Color{192,192,192,255}
                   : (pos==3) ? Color{205,127,50,255}
                              : Color{200,200,210,255};
 
-    DrawText(TextFormat("%2d", pos), X_POS, y, 16, posCol);
+    DrawText(row.pos, X_POS, y, 16, posCol);
     DrawRectangle(X_ID - 14, y+2, 10, 10, colorFor(c.id)); // color swatch
-    DrawText(buf_id,  X_ID,   y, 16, colorFor(c.id));
-    DrawText(buf_lap, X_LAP,  y, 16, colDefault);
-    DrawText(buf_gap, X_GAP,  y, 16, colDefault);
-    DrawText(buf_last,X_LAST, y, 16, colDefault);
-    DrawText(buf_best,X_BEST, y, 16, colDefault);
-    DrawText(buf_s1,  X_S1,   y, 16, sectorColor(c.s1_last, c.s1_best, s1_min));
-    DrawText(buf_s2,  X_S2,   y, 16, sectorColor(c.s2_last, c.s2_best, s2_min));
-    DrawText(buf_s3,  X_S3,   y, 16, sectorColor(c.s3_last, c.s3_best, s3_min));
+    DrawText(row.id,   X_ID,   y, 16, colorFor(c.id));
+    DrawText(row.lap,  X_LAP,  y, 16, colDefault);
+    DrawText(row.gap,  X_GAP,  y, 16, colDefault);
+    DrawText(row.last, X_LAST, y, 16, colDefault);
+    DrawText(row.best, X_BEST, y, 16, colDefault);
+    DrawText(row.s1,   X_S1,   y, 16, sectorColor(c.s1_last, c.s1_best, s1_min));
+    DrawText(row.s2,   X_S2,   y, 16, sectorColor(c.s2_last, c.s2_best, s2_min));
+    DrawText(row.s3,   X_S3,   y, 16, sectorColor(c.s3_last, c.s3_best, s3_min));
 
     y += row_h;
-    ++pos;
   }
 }
 
@@ -590,7 +549,7 @@ void ViewerApp::draw_hud_(const SimSnapshot& draw) {
         (std::string(" (saved: ") + g_race_state.saved_json_path + ", " + g_race_state.saved_csv_path + ")").c_str()) : ""
     );
   } else {
-    char dur[32]; fmt_time(g_race_cfg.target_seconds, dur, sizeof(dur));
+    char dur[32]; format_race_time(g_race_cfg.target_seconds, dur, sizeof(dur));
     std::snprintf(race_line, sizeof(race_line),
       "Race: Time %s  —  %s%s",
       dur,
@@ -600,18 +559,70 @@ void ViewerApp::draw_hud_(const SimSnapshot& draw) {
     );
   }
 
-  DrawText(TextFormat("track=%s  cars=%d  lap=%llu  sim=%.2fs  warp=%s",
+  DrawText(TextFormat("track=%s  cars=%d  lap=%llu  sim=%.2fs  warp=%s%s",
                       preset,
                       (int)draw.cars.size(),
                       (unsigned long long)draw.lap,
                       draw.sim_time,
-                      warpLabel(warp)),
+                      warpLabel(warp),
+                      sim_.recording() ? "  REC" : ""),
            20, 20, 20, Color{220,235,220,255});
 
+  if (replay_) {
+    char pos[32];
+    format_race_time(replay_->time(), pos, sizeof(pos));
+    std::snprintf(race_line, sizeof(race_line), "Replay: %s  %s%s  (, . seek 10s | Home: start)",
+                  pos, replay_->paused() ? "Paused " : "", warpLabel(replay_->warp()));
+  }
   DrawText(race_line, 20, 46, 18, Color{235,220,220,255});
 
-  DrawText("Space: Pause/Resume | 1..5: 0.25x 0.5x 1x 2x 4x | W/S or +/-: Zoom | Arrows: Pan | N: Cars | T: Track | C: Center | M: Laps/Time | [ ]: Target | R: Reset",
+  DrawText("Space: Pause/Resume | 1..5: 0.25x 0.5x 1x 2x 4x | W/S or +/-: Zoom | Arrows: Pan | N: Cars | T: Track | C: Center | M: Laps/Time | [ ]: Target | R: Reset | L: Record | F3: Profiler",
            20, 72, 14, Color{190,205,190,255});
 }
 
+void ViewerApp::draw_profiler_() {
+  const StageProfiler* profs[2] = { &profiler_, &sim_.profiler() };
+  const char* titles[2] = { "Viewer", "Sim" };
+
+  const int row_h = 16;
+  const int pad   = 8;
+  const int box_w = 300;
+  int rows = 1; // tick budget line
+  for (const auto* p : profs) rows += 1 + int(p->size());
+  const int x0 = GetScreenWidth() - box_w - 20;
+  const int y0 = 20;
+  const int X_NAME = x0 + pad;
+  const int X_P50  = x0 + pad + 150;
+  const int X_P99  = x0 + pad + 220;
+
+  DrawRectangle(x0, y0, box_w, pad*2 + row_h*rows, Color{24,24,28,220});
+  const Color hdr = Color{220,220,230,255};
+  const Color col = Color{200,200,210,255};
+  int y = y0 + pad;
+  char buf[32];
+  for (int k = 0; k < 2; ++k) {
+    DrawText(titles[k],  X_NAME, y, 14, hdr);
+    DrawText("p50 ms",   X_P50,  y, 14, hdr);
+    DrawText("p99 ms",   X_P99,  y, 14, hdr);
+    y += row_h;
+    for (std::size_t i = 0; i < profs[k]->size(); ++i) {
+      const StageHistogram& h = profs[k]->stage(i);
+      DrawText(profs[k]->name(i), X_NAME, y, 14, col);
+      std::snprintf(buf, sizeof(buf), "%.3f", h.quantile_ns(0.50) * 1e-6);
+      DrawText(buf, X_P50, y, 14, col);
+      std::snprintf(buf, sizeof(buf), "%.3f", h.quantile_ns(0.99) * 1e-6);
+      DrawText(buf, X_P99, y, 14, col);
+      y += row_h;
+    }
+  }
+
+  const TickStats& ts = sim_.tick_stats();
+  char line[128];
+  std::snprintf(line, sizeof(line), "tick %.1f Hz  overruns %llu  late %llu",
+                ts.tick_hz.load(std::memory_order_relaxed),
+                (unsigned long long)ts.overruns.load(std::memory_order_relaxed),
+                (unsigned long long)ts.late_ticks.load(std::memory_order_relaxed));
+  DrawText(line, X_NAME, y, 14, hdr);
+}
+
 } // namespace f1tm
@@ -0,0 +1,91 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <vector>
+
+#include <f1tm/car_batch.hpp>
+
+using Catch::Approx;
+using namespace f1tm;
+
+static bool same(MeshColor a, MeshColor b) {
+  return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+TEST_CASE("CarColorTable assigns palette colors in first-seen order") {
+  CarColorTable t;
+  const auto pal = CarColorTable::palette();
+  REQUIRE(same(t.color(7), pal[0]));
+  REQUIRE(same(t.color(2), pal[1]));
+  REQUIRE(same(t.color(7), pal[0])); // stable
+  for (CarId id = 100; id < 100 + pal.size(); ++id) (void)t.color(id);
+  REQUIRE(same(t.color(500), pal[(2 + pal.size()) % pal.size()])); // wraps
+  REQUIRE(same(t.color(CarColorTable::kDenseIds + 3), pal[3]));
+}
+
+TEST_CASE("CarBatch emits a fixed glyph per car at the screen position") {
+  std::vector<CarPose> cars(3);
+  for (std::size_t i = 0; i < cars.size(); ++i) {
+    cars[i].id = CarId(i);
+    cars[i].x = 10.0 * double(i);
+    cars[i].y = 5.0;
+    cars[i].heading_rad = 0.0;
+  }
+  CarColorTable colors;
+  CarBatch b;
+  b.build(cars, 2.0f, 100.0f, 200.0f, colors);
+  REQUIRE(b.car_count() == 3);
+  REQUIRE(b.vertices().size() == 3 * CarBatch::kVertsPerCar);
+
+  // Car 1 at (10, 5) m -> (120, 190) px; heading 0 puts the nose 12 px to the right.
+  const auto* v = b.vertices().data() + CarBatch::kVertsPerCar;
+  REQUIRE(v[0].x == Approx(132.0f));
+  REQUIRE(v[0].y == Approx(190.0f));
+  REQUIRE(v[3].x == Approx(120.0f)); // marker fan centre
+  REQUIRE(v[3].y == Approx(190.0f));
+  for (std::size_t k = 0; k < CarBatch::kVertsPerCar; ++k) REQUIRE(same(v[k].c, colors.color(1)));
+}
+
+TEST_CASE("CarBatch triangles are counter-clockwise on screen for any heading") {
+  std::vector<CarPose> cars(16);
+  for (std::size_t i = 0; i < cars.size(); ++i) {
+    cars[i].id = CarId(i);
+    cars[i].heading_rad = 0.4 * double(i);
+  }
+  CarColorTable colors;
+  CarBatch b;
+  b.build(cars, 1.0f, 0.0f, 0.0f, colors);
+  const auto& v = b.vertices();
+  for (std::size_t i = 0; i < v.size(); i += 3) {
+    const float cross = (v[i+1].x - v[i].x) * (v[i+2].y - v[i].y) -
+                        (v[i+1].y - v[i].y) * (v[i+2].x - v[i].x);
+    REQUIRE(cross < 0.0f); // y-down screen space
+  }
+}
+
+TEST_CASE("CarBatch reuses its buffer across frames") {
+  std::vector<CarPose> cars(50);
+  CarColorTable colors;
+  CarBatch b;
+  b.build(cars, 1.0f, 0.0f, 0.0f, colors);
+  const auto* data = b.vertices().data();
+  cars.resize(20);
+  b.build(cars, 1.0f, 0.0f, 0.0f, colors);
+  REQUIRE(b.car_count() == 20);
+  REQUIRE(b.vertices().data() == data);
+  b.build({}, 1.0f, 0.0f, 0.0f, colors);
+  REQUIRE(b.car_count() == 0);
+}
+
+TEST_CASE("CarBatch skips cars outside the view box") {
+  std::vector<CarPose> cars(3);
+  cars[0].id = 0; cars[0].x = 10.0;    // on screen
+  cars[1].id = 1; cars[1].x = 5000.0;  // far right
+  cars[2].id = 2; cars[2].x = -105.0;  // centre just off the left edge, glyph still visible
+  CarColorTable colors;
+  CarBatch b;
+  const Box2 screen{0.0f, 0.0f, 200.0f, 200.0f};
+  b.build(cars, 1.0f, 100.0f, 100.0f, colors, &screen);
+  REQUIRE(b.car_count() == 2);
+  REQUIRE(b.vertices()[0].x == Approx(122.0f)); // car 0's nose
+  REQUIRE(same(colors.color(1), CarColorTable::palette()[1])); // culled cars keep their order
+}
@@ -0,0 +1,134 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <random>
+#include <vector>
+
+#include <f1tm/degradation.hpp>
+#include <f1tm/monte_carlo.hpp>
+#include <f1tm/race.hpp>
+#include <f1tm/race_batch.hpp>
+#include <f1tm/stint.hpp>
+
+using Catch::Approx;
+using namespace f1tm;
+
+namespace {
+template <class D>
+double summed(const D& d, int n) {
+  double s = 0.0;
+  for (int i = 0; i < n; ++i) s += d.lap_delta(i);
+  return s;
+}
+} // namespace
+
+TEST_CASE("Closed-form cumulative matches per-lap sums") {
+  const LinearDeg lin{0.08};
+  const QuadraticDeg quad{0.05, 0.002};
+  const CliffDeg cliff{0.04, 1.2, 3, 18, 0.6};
+  const ExponentialDeg expo{0.1, 0.07};
+  for (int n = 0; n <= 40; ++n) {
+    REQUIRE(lin.cumulative(n) == Approx(summed(lin, n)).margin(1e-9));
+    REQUIRE(quad.cumulative(n) == Approx(summed(quad, n)).margin(1e-9));
+    REQUIRE(cliff.cumulative(n) == Approx(summed(cliff, n)).margin(1e-9));
+    REQUIRE(expo.cumulative(n) == Approx(summed(expo, n)).margin(1e-9));
+  }
+  // Cliff off and zero-rate exponential degrade gracefully
+  REQUIRE(CliffDeg{0.1, 0.0, 0, 0, 5.0}.cumulative(10) == Approx(LinearDeg{0.1}.cumulative(10)));
+  REQUIRE(ExponentialDeg{0.5, 0.0}.cumulative(10) == 0.0);
+}
+
+TEST_CASE("LinearDeg reproduces estimate_stint_time") {
+  for (int laps : {-1, 0, 1, 7, 25}) {
+    for (double base : {-1.0, 0.0, 90.0}) {
+      for (double deg : {-0.1, 0.0, 0.07}) {
+        const StintParams s{laps, base, deg};
+        REQUIRE(estimate_stint_time(ModelStint<LinearDeg>{laps, base, {deg}}) == estimate_stint_time(s));
+      }
+    }
+  }
+  REQUIRE(stint_time(10, 90.0, QuadraticDeg{-0.1, 0.0}) == 0.0);
+}
+
+TEST_CASE("DegradationTable matches the source model") {
+  const CliffDeg cliff{0.04, 1.2, 3, 18, 0.6};
+  const DegradationTable<CliffDeg> table(cliff, 20);
+  for (int n = -1; n <= 35; ++n) {
+    REQUIRE(table.cumulative(n) == Approx(cliff.cumulative(n < 0 ? 0 : n)).margin(1e-9));
+  }
+  REQUIRE(stint_time(30, 90.0, table) == Approx(stint_time(30, 90.0, cliff)));
+}
+
+TEST_CASE("Templated race_time_batch matches the scalar path") {
+  std::mt19937 rng(11);
+  std::uniform_int_distribution<int> nst(1, 3), laps(0, 30);
+  std::uniform_real_distribution<double> base(80.0, 95.0), lin(0.0, 0.1), quad(0.0, 0.004);
+
+  const std::size_t N = 300, K = 3;
+  StrategyBatch batch(K);
+  std::vector<std::vector<ModelStint<QuadraticDeg>>> plans;
+  for (std::size_t s = 0; s < N; ++s) {
+    const int n = nst(rng);
+    std::vector<ModelStint<QuadraticDeg>> p;
+    std::vector<StintParams> st;
+    std::vector<PitParams> pits;
+    for (int k = 0; k < n; ++k) {
+      p.push_back({laps(rng), base(rng), {lin(rng), quad(rng)}});
+      st.push_back({p.back().laps, p.back().baseLap, 0.0});
+    }
+    for (int k = 0; k + 1 < n; ++k) pits.push_back({2.5, 19.0});
+    REQUIRE(batch.add(st, pits, std::vector<double>(pits.size(), 1.0)));
+    plans.push_back(p);
+  }
+
+  // Column-major models; padding stints get an empty model.
+  std::vector<QuadraticDeg> models(K * N);
+  for (std::size_t i = 0; i < N; ++i) {
+    for (std::size_t k = 0; k < plans[i].size(); ++k) models[k * N + i] = plans[i][k].deg;
+  }
+  std::vector<double> out(N);
+  REQUIRE(race_time_batch<QuadraticDeg>(batch, models, out));
+  for (std::size_t i = 0; i < N; ++i) {
+    const StrategyCandidate c = strategy_candidate(plans[i]);
+    REQUIRE(out[i] == Approx(c.stint_time + double(c.stops) * (2.5 + 19.0)).epsilon(1e-12));
+  }
+
+  std::vector<QuadraticDeg> short_models(N);
+  REQUIRE_FALSE(race_time_batch<QuadraticDeg>(batch, short_models, out));
+}
+
+TEST_CASE("Monte Carlo accepts policy-based stints") {
+  const auto track = track_by_key("Bahrain");
+  REQUIRE(track);
+  const std::vector<std::vector<StintParams>> linear{
+    {{20, 90.0, 0.05}, {33, 90.5, 0.03}},
+    {{15, 90.0, 0.05}, {20, 90.5, 0.03}, {18, 90.2, 0.04}},
+  };
+  std::vector<std::vector<ModelStint<LinearDeg>>> model;
+  for (const auto& p : linear) {
+    model.emplace_back();
+    for (const auto& s : p) model.back().push_back({s.laps, s.baseLap, {s.degradationPerLap}});
+  }
+  MonteCarloOptions opt;
+  opt.scenarios = 5000;
+  opt.seed = 3;
+  opt.p_sc = 0.3;
+  const auto a = simulate_strategy_outcomes(linear, *track, opt);
+  const auto cands = strategy_candidates(model);
+  REQUIRE(a);
+  REQUIRE(cands);
+  const auto b = simulate_candidate_outcomes(*cands, *track, opt);
+  REQUIRE(b);
+  for (std::size_t c = 0; c < linear.size(); ++c) {
+    REQUIRE(a->outcomes[c].mean == b->outcomes[c].mean);
+  }
+  REQUIRE_FALSE(strategy_candidates(std::vector<std::vector<ModelStint<CliffDeg>>>{{}}).has_value());
+
+  // Cliff-limited tyres make the one-stop slower than the same stints under LinearDeg
+  const CliffDeg worn{0.05, 0.0, 0, 25, 0.8};
+  const StrategyCandidate one = strategy_candidate(std::vector<ModelStint<CliffDeg>>{
+    {20, 90.0, worn}, {33, 90.5, worn}});
+  const auto cmp = compare_candidates(one, (*cands)[0], *track);
+  REQUIRE(cmp);
+  REQUIRE(cmp->mean_delta == Approx(one.stint_time - (*cands)[0].stint_time));
+  REQUIRE(cmp->mean_delta > 0.0);
+}
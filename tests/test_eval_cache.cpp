@@ -0,0 +1,136 @@
+#include <catch2/catch_test_macros.hpp>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <f1tm/eval_cache.hpp>
+#include <f1tm/race.hpp>
+
+using namespace f1tm;
+
+namespace {
+PackedEventStream stream(std::initializer_list<RaceEvent> ev) {
+  PackedEventStream s;
+  for (RaceEvent e : ev) s.push_back(e);
+  return s;
+}
+
+std::optional<double> cached(EvaluationCache& cache, const std::vector<StintParams>& st,
+                             const Track& t, const PackedEventStream& ev) {
+  return cache.get_or_compute(StrategyKey(st, t, ev), [&] { return race_time_with_track(st, t, ev); });
+}
+} // namespace
+
+TEST_CASE("StrategyKey is canonical over quantized inputs") {
+  const auto t = track_by_key("Bahrain");
+  REQUIRE(t);
+  const std::vector<StintParams> st{{20, 90.0, 0.05}, {30, 90.5, 0.03}};
+  const StrategyKey a(st, *t, stream({RaceEvent::SC}));
+
+  auto st2 = st;
+  st2[0].baseLap += 1e-12;  // below the quantum
+  REQUIRE(StrategyKey(st2, *t, stream({RaceEvent::SC})) == a);
+
+  st2[0].baseLap += 1e-6;
+  REQUIRE_FALSE(StrategyKey(st2, *t, stream({RaceEvent::SC})) == a);
+  REQUIRE_FALSE(StrategyKey(st, *t, stream({RaceEvent::VSC})) == a);
+  Track renamed = *t;
+  renamed.key = "Bahrain2";
+  REQUIRE_FALSE(StrategyKey(st, renamed, stream({RaceEvent::SC})) == a);
+
+  // Context words keep differently scored evaluations of one strategy apart
+  const std::uint64_t ctx1[] = {1, StrategyKey::quantized(0.9)};
+  const std::uint64_t ctx2[] = {1, StrategyKey::quantized(0.5)};
+  const StrategyKey c1(st, *t, stream({RaceEvent::SC}), ctx1);
+  REQUIRE_FALSE(c1 == a);
+  REQUIRE(StrategyKey(st, *t, stream({RaceEvent::SC}), ctx1) == c1);
+  REQUIRE_FALSE(StrategyKey(st, *t, stream({RaceEvent::SC}), ctx2) == c1);
+}
+
+TEST_CASE("EvaluationCache counts hits and misses") {
+  const auto t = track_by_key("Bahrain");
+  REQUIRE(t);
+  EvaluationCache cache;
+  const std::vector<StintParams> st{{3, 90.0, 0.2}, {2, 91.0, 0.1}};
+  const auto sc = stream({RaceEvent::SC});
+
+  const auto expected = race_time_with_track(st, *t, sc);
+  REQUIRE(expected);
+  REQUIRE(cached(cache, st, *t, sc) == expected);
+  REQUIRE(cached(cache, st, *t, sc) == expected);
+  REQUIRE(cache.stats().misses == 1);
+  REQUIRE(cache.stats().hits == 1);
+  REQUIRE(cache.size() == 1);
+  REQUIRE(cache.hit_rate() == 0.5);
+
+  cache.clear();
+  REQUIRE(cache.size() == 0);
+  REQUIRE(cached(cache, st, *t, sc) == expected);
+  REQUIRE(cache.stats().misses == 2);
+}
+
+TEST_CASE("EvaluationCache evicts least recently used entries") {
+  const auto t = track_by_key("Bahrain");
+  REQUIRE(t);
+  EvaluationCache cache(EvalCacheConfig{4, 1});
+  REQUIRE(cache.capacity() == 4);
+  auto strat = [](int l) { return std::vector<StintParams>{{l, 90.0, 0.05}, {50 - l, 90.5, 0.03}}; };
+  const auto green = stream({RaceEvent::Green});
+
+  for (int l = 10; l < 14; ++l) cached(cache, strat(l), *t, green);
+  cached(cache, strat(10), *t, green);   // touch 10; 11 is now oldest
+  cached(cache, strat(20), *t, green);   // evicts 11
+  REQUIRE(cache.size() == 4);
+  REQUIRE(cache.stats().evictions == 1);
+
+  const auto hits = cache.stats().hits.load();
+  cached(cache, strat(10), *t, green);
+  REQUIRE(cache.stats().hits == hits + 1);
+  const auto misses = cache.stats().misses.load();
+  REQUIRE(cached(cache, strat(11), *t, green) == race_time_with_track(strat(11), *t, green));
+  REQUIRE(cache.stats().misses == misses + 1);
+}
+
+TEST_CASE("EvaluationCache is safe under concurrent use") {
+  const auto t = track_by_key("Bahrain");
+  REQUIRE(t);
+  EvaluationCache cache(EvalCacheConfig{64, 4});
+  const auto sc = stream({RaceEvent::SC});
+  std::vector<std::thread> th;
+  std::vector<int> bad(4, 0);
+  for (int w = 0; w < 4; ++w) {
+    th.emplace_back([&, w] {
+      for (int i = 0; i < 2000; ++i) {
+        const int l = 5 + (i * 7 + w) % 40;
+        const std::vector<StintParams> st{{l, 90.0, 0.05}, {50 - l, 90.5, 0.03}};
+        if (cached(cache, st, *t, sc) != race_time_with_track(st, *t, sc)) ++bad[w];
+      }
+    });
+  }
+  for (auto& x : th) x.join();
+  for (int b : bad) REQUIRE(b == 0);
+  REQUIRE(cache.stats().hits + cache.stats().misses == 8000);
+  REQUIRE(cache.size() <= cache.capacity());
+}
+
+TEST_CASE("get_or_compute memoizes a costly evaluator") {
+  const auto t = track_by_key("Bahrain");
+  REQUIRE(t);
+  EvaluationCache cache;
+  const std::vector<StintParams> st{{20, 90.0, 0.05}, {30, 90.5, 0.03}};
+  const StrategyKey key(st, *t, stream({RaceEvent::Green}));
+  int calls = 0;
+  auto eval = [&]() -> std::optional<double> { ++calls; return 42.0; };
+  REQUIRE(cache.get_or_compute(key, eval) == 42.0);
+  REQUIRE(cache.get_or_compute(key, eval) == 42.0);
+  REQUIRE(calls == 1);
+
+  // Failed evaluations are retried
+  const StrategyKey other(st, *t, stream({RaceEvent::SC}));
+  auto fail = [&]() -> std::optional<double> { ++calls; return std::nullopt; };
+  REQUIRE_FALSE(cache.get_or_compute(other, fail));
+  REQUIRE_FALSE(cache.get_or_compute(other, fail));
+  REQUIRE(calls == 3);
+  REQUIRE(cache.size() == 1);
+}
@@ -0,0 +1,96 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <f1tm/event_stream.hpp>
+#include <f1tm/events.hpp>
+#include <f1tm/race.hpp>
+#include <f1tm/track.hpp>
+
+using Catch::Approx;
+using namespace f1tm;
+
+TEST_CASE("parse_race_event and to_string round-trip") {
+  for (auto e : {RaceEvent::Green, RaceEvent::VSC, RaceEvent::SC}) {
+    REQUIRE(parse_race_event(to_string(e)) == e);
+  }
+  REQUIRE(parse_race_event("vsc") == RaceEvent::VSC);
+  REQUIRE(parse_race_event("") == RaceEvent::Green);
+  REQUIRE_FALSE(parse_race_event("RED").has_value());
+  REQUIRE_FALSE(parse_race_event("SCX").has_value());
+}
+
+TEST_CASE("PackedEventStream packs 2 bits per event") {
+  PackedEventStream s;
+  std::vector<RaceEvent> ref;
+  for (int i = 0; i < 70; ++i) {
+    const auto e = RaceEvent(i % 3);
+    s.push_back(e);
+    ref.push_back(e);
+  }
+  REQUIRE(s.size() == 70);
+  REQUIRE(s.words().size() == 3);
+  for (std::size_t i = 0; i < ref.size(); ++i) REQUIRE(s[i] == ref[i]);
+  REQUIRE(s.count(RaceEvent::Green) == 24);
+  REQUIRE(s.count(RaceEvent::VSC) == 23);
+  REQUIRE(s.count(RaceEvent::SC) == 23);
+
+  s.set(5, RaceEvent::SC);
+  REQUIRE(s[5] == RaceEvent::SC);
+  REQUIRE(s[4] == ref[4]);
+  REQUIRE(s[6] == ref[6]);
+
+  s.resize(33); // truncation clears bits past the end
+  REQUIRE(s.count(RaceEvent::Green) + s.count(RaceEvent::VSC) + s.count(RaceEvent::SC) == 33);
+  s.resize(40);
+  for (std::size_t i = 33; i < 40; ++i) REQUIRE(s[i] == RaceEvent::Green);
+}
+
+TEST_CASE("typed generation matches the string adapter") {
+  auto track = track_by_key("Bahrain");
+  REQUIRE(track.has_value());
+  std::mt19937 r1(9), r2(9), r3(9);
+  const auto stream = simulate_pit_event_stream(100, 0.3, 0.2, r1);
+  const auto strings = simulate_pit_events(100, 0.3, 0.2, r2);
+  const auto factors = simulate_lane_factors(100, *track, 0.3, 0.2, r3);
+  REQUIRE(strings.size() == 100);
+  const auto from_strings = lane_factors_from_events(*track, strings);
+  const auto from_stream = lane_factors_from_stream(*track, stream);
+  for (std::size_t i = 0; i < 100; ++i) {
+    REQUIRE(strings[i] == to_string(stream[i]));
+    REQUIRE(from_stream[i] == from_strings[i]);
+    REQUIRE(factors[i] == from_strings[i]);
+  }
+
+  std::vector<double> small(10);
+  REQUIRE_FALSE(lane_factors_from_stream(*track, stream, small));
+}
+
+TEST_CASE("counter-based event streams are reproducible per stream") {
+  const CounterRng rng(5);
+  const auto a = simulate_pit_event_stream(64, 0.4, 0.4, rng, 3);
+  const auto b = simulate_pit_event_stream(64, 0.4, 0.4, rng, 3);
+  const auto c = simulate_pit_event_stream(64, 0.4, 0.4, rng, 4);
+  REQUIRE(std::vector<std::uint64_t>(a.words().begin(), a.words().end()) ==
+          std::vector<std::uint64_t>(b.words().begin(), b.words().end()));
+  REQUIRE(std::vector<std::uint64_t>(a.words().begin(), a.words().end()) !=
+          std::vector<std::uint64_t>(c.words().begin(), c.words().end()));
+}
+
+TEST_CASE("race_time_with_track accepts a typed event stream") {
+  auto track = track_by_key("Bahrain");
+  REQUIRE(track.has_value());
+  std::vector<StintParams> stints{{20, 90.0, 0.1}, {20, 90.5, 0.08}, {17, 91.0, 0.05}};
+  PackedEventStream ev;
+  ev.push_back(RaceEvent::SC);
+  ev.push_back(RaceEvent::Green);
+  auto typed = race_time_with_track(stints, *track, ev);
+  auto strings = race_time_with_track(stints, *track, std::vector<std::string>{"SC", "GREEN"});
+  REQUIRE(typed.has_value());
+  REQUIRE(strings.has_value());
+  REQUIRE(*typed == *strings);
+  ev.push_back(RaceEvent::VSC);
+  REQUIRE_FALSE(race_time_with_track(stints, *track, ev).has_value());
+}
@@ -0,0 +1,178 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <set>
+#include <vector>
+
+#include <f1tm/counter_rng.hpp>
+#include <f1tm/monte_carlo.hpp>
+#include <f1tm/race.hpp>
+#include <f1tm/strategy.hpp>
+#include <f1tm/track.hpp>
+
+using Catch::Approx;
+using namespace f1tm;
+
+static const std::vector<std::vector<StintParams>> kCandidates{
+  {{20, 90.0, 0.20}, {37, 91.0, 0.05}},                    // 1 stop
+  {{15, 90.0, 0.20}, {21, 90.6, 0.09}, {21, 90.6, 0.09}},  // 2 stops
+  {{57, 91.1, 0.05}},                                       // no stop
+};
+
+TEST_CASE("CounterRng is a pure function of key, stream and counter") {
+  const CounterRng a(42), b(42), c(43);
+  REQUIRE(a.bits(5, 7) == b.bits(5, 7));
+  REQUIRE(a.bits(5, 7) != c.bits(5, 7));
+  REQUIRE(a.bits(5, 7) != a.bits(7, 5));
+  REQUIRE(a.split(1).bits(0, 0) != a.split(2).bits(0, 0));
+
+  double sum = 0.0;
+  for (std::uint64_t i = 0; i < 100000; ++i) {
+    const double u = a.uniform(i, 0);
+    REQUIRE(u >= 0.0);
+    REQUIRE(u < 1.0);
+    sum += u;
+  }
+  REQUIRE(sum / 100000.0 == Approx(0.5).margin(0.01));
+}
+
+TEST_CASE("simulate_strategy_outcomes is bit-identical for any thread count") {
+  auto track = track_by_key("Bahrain");
+  REQUIRE(track.has_value());
+  MonteCarloOptions opt;
+  opt.scenarios = 50000;
+  opt.seed = 11;
+  opt.p_sc = 0.2;
+  opt.p_vsc = 0.15;
+  opt.threads = 1;
+  const auto r1 = simulate_strategy_outcomes(kCandidates, *track, opt);
+  opt.threads = 3;
+  const auto r3 = simulate_strategy_outcomes(kCandidates, *track, opt);
+  opt.threads = 8;
+  const auto r8 = simulate_strategy_outcomes(kCandidates, *track, opt);
+  REQUIRE(r1.has_value());
+  REQUIRE(r3.has_value());
+  REQUIRE(r8.has_value());
+  for (const auto* r : {&*r3, &*r8}) {
+    REQUIRE(r->beats == r1->beats);
+    for (std::size_t c = 0; c < kCandidates.size(); ++c) {
+      REQUIRE(r->outcomes[c].mean == r1->outcomes[c].mean);
+      REQUIRE(r->outcomes[c].stddev == r1->outcomes[c].stddev);
+      REQUIRE(r->outcomes[c].quantiles == r1->outcomes[c].quantiles);
+      REQUIRE(r->outcomes[c].win_prob == r1->outcomes[c].win_prob);
+    }
+  }
+}
+
+TEST_CASE("simulate_strategy_outcomes agrees with the analytic expectation") {
+  auto track = track_by_key("Bahrain");
+  REQUIRE(track.has_value());
+  MonteCarloOptions opt;
+  opt.scenarios = 200000;
+  opt.p_sc = 0.2;
+  opt.p_vsc = 0.1;
+  const auto r = simulate_strategy_outcomes(kCandidates, *track, opt);
+  REQUIRE(r.has_value());
+
+  const double ef = 0.2 * track->sc_lane_factor + 0.1 * track->vsc_lane_factor + 0.7;
+  double win_sum = 0.0;
+  for (std::size_t c = 0; c < kCandidates.size(); ++c) {
+    const auto& o = r->outcomes[c];
+    const std::size_t stops = kCandidates[c].size() - 1;
+    const std::vector<double> green(stops, 1.0);
+    const std::vector<PitParams> pits(stops, track_pit_params(*track));
+    const double all_green = *race_time_with_pits_under(kCandidates[c], pits, green);
+    const double expect = all_green - double(stops) * track->pit_lane_delta_s * (1.0 - ef);
+    REQUIRE(o.mean == Approx(expect).margin(0.05));
+    REQUIRE(o.max <= all_green + 1e-9);
+    REQUIRE(o.quantiles.size() == 3);
+    REQUIRE(o.min <= o.quantiles[0]);
+    REQUIRE(o.quantiles[0] <= o.quantiles[1]);
+    REQUIRE(o.quantiles[1] <= o.quantiles[2]);
+    REQUIRE(o.quantiles[2] <= o.max);
+    win_sum += o.win_prob;
+    REQUIRE(r->p_beats(c, c) == 0.0);
+  }
+  REQUIRE(win_sum == Approx(1.0));
+  // The no-stop candidate has zero variance
+  REQUIRE(r->outcomes[2].stddev == 0.0);
+}
+
+TEST_CASE("simulate_strategy_outcomes rejects malformed input") {
+  auto track = track_by_key("Bahrain");
+  REQUIRE(track.has_value());
+  REQUIRE_FALSE(simulate_strategy_outcomes({}, *track).has_value());
+  REQUIRE_FALSE(simulate_strategy_outcomes({{}}, *track).has_value());
+  MonteCarloOptions opt;
+  opt.quantiles = {1.5};
+  REQUIRE_FALSE(simulate_strategy_outcomes(kCandidates, *track, opt).has_value());
+}
+
+TEST_CASE("rank_strategies_under_risk memoizes scores across repeated searches") {
+  auto track = track_by_key("Bahrain");
+  REQUIRE(track.has_value());
+  const std::vector<Compound> compounds{{"S", 90.0, 0.20, 0}, {"M", 90.6, 0.09, 0}, {"H", 91.1, 0.05, 0}};
+  RiskRankOptions opt;
+  opt.mc.scenarios = 4096;
+  opt.mc.seed = 3;
+  opt.mc.p_sc = 0.2;
+  opt.mc.p_vsc = 0.1;
+  opt.mc.threads = 1;
+  EvaluationCache cache;
+
+  // The search re-run as its pit-loss assumption is swept: top-K lists overlap heavily.
+  std::set<std::vector<std::pair<std::size_t, int>>> distinct;
+  for (double lane : {1.0, 0.9, 0.8, 0.7, 0.8, 0.9, 1.0}) {
+    StrategySearchOptions so;
+    so.top_k = 8;
+    so.lane_factor = lane;
+    const auto found = optimize_pit_strategy(57, *track, compounds, so);
+    REQUIRE(found.size() == 8);
+    std::vector<std::vector<StintParams>> plans;
+    for (const auto& s : found) {
+      plans.push_back(strategy_stints(s, compounds));
+      std::vector<std::pair<std::size_t, int>> sig;
+      for (const auto& st : s.stints) sig.emplace_back(st.compound, st.laps);
+      distinct.insert(sig);
+    }
+    const auto cached = rank_strategies_under_risk(plans, *track, opt, &cache);
+    const auto direct = rank_strategies_under_risk(plans, *track, opt);
+    REQUIRE(cached.has_value());
+    REQUIRE(direct.has_value());
+    for (std::size_t i = 0; i < plans.size(); ++i) {
+      REQUIRE((*cached)[i].index == (*direct)[i].index);
+      REQUIRE((*cached)[i].score == (*direct)[i].score);
+      if (i > 0) REQUIRE((*cached)[i - 1].score <= (*cached)[i].score);
+    }
+  }
+  REQUIRE(cache.stats().misses == distinct.size());
+  REQUIRE(cache.stats().hits == 7 * 8 - distinct.size());
+  REQUIRE(cache.stats().hits > cache.stats().misses);
+
+  // Other options score differently, so they must not hit
+  const auto hits = cache.stats().hits.load();
+  opt.quantile = 0.5;
+  REQUIRE(rank_strategies_under_risk({kCandidates[0]}, *track, opt, &cache).has_value());
+  REQUIRE(cache.stats().hits == hits);
+
+  REQUIRE_FALSE(rank_strategies_under_risk({}, *track, opt, &cache).has_value());
+  REQUIRE_FALSE(rank_strategies_under_risk({{}}, *track, opt, &cache).has_value());
+  opt.quantile = 1.5;
+  REQUIRE_FALSE(rank_strategies_under_risk(kCandidates, *track, opt, &cache).has_value());
+}
+
+TEST_CASE("rank_strategies_under_risk scores match simulate_strategy_outcomes") {
+  auto track = track_by_key("Bahrain");
+  REQUIRE(track.has_value());
+  RiskRankOptions opt;
+  opt.mc.scenarios = 20000;
+  opt.mc.seed = 5;
+  opt.mc.p_sc = 0.25;
+  opt.quantile = 0.95;
+  const auto ranked = rank_strategies_under_risk(kCandidates, *track, opt);
+  MonteCarloOptions mc = opt.mc;
+  mc.quantiles = {0.95};
+  const auto full = simulate_strategy_outcomes(kCandidates, *track, mc);
+  REQUIRE(ranked.has_value());
+  REQUIRE(full.has_value());
+  for (const auto& r : *ranked) REQUIRE(r.score == full->outcomes[r.index].quantiles[0]);
+}
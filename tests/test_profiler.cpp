@@ -0,0 +1,77 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <f1tm/profiler.hpp>
+
+using Catch::Approx;
+using namespace f1tm;
+
+TEST_CASE("StageHistogram buckets cover values within 1/8") {
+  for (std::uint64_t v : {0ull, 1ull, 7ull, 8ull, 15ull, 16ull, 17ull, 1000ull, 123456789ull, 1ull << 39}) {
+    const auto b = StageHistogram::bucket_of(v);
+    REQUIRE(b < StageHistogram::kBuckets);
+    REQUIRE(StageHistogram::bucket_lower(b) <= v);
+    REQUIRE(v < StageHistogram::bucket_lower(b) + StageHistogram::bucket_width(b));
+    REQUIRE(StageHistogram::bucket_width(b) * 8 <= std::max<std::uint64_t>(8, v));
+  }
+  REQUIRE(StageHistogram::bucket_of(~std::uint64_t{0}) == StageHistogram::kBuckets - 1);
+}
+
+TEST_CASE("StageHistogram quantiles track a known distribution") {
+  StageHistogram h;
+  REQUIRE(h.quantile_ns(0.5) == 0.0);
+  for (std::uint64_t i = 1; i <= 1000; ++i) h.record(i * 1000); // 1..1000 us
+  REQUIRE(h.count() == 1000);
+  REQUIRE(h.max_ns() == 1000000);
+  REQUIRE(h.mean_ns() == Approx(500500.0));
+  REQUIRE(h.quantile_ns(0.5) == Approx(500000.0).epsilon(0.07));
+  REQUIRE(h.quantile_ns(0.99) == Approx(990000.0).epsilon(0.07));
+  REQUIRE(h.quantile_ns(1.0) <= 1000000.0);
+
+  h.reset();
+  REQUIRE(h.count() == 0);
+  REQUIRE(h.quantile_ns(0.99) == 0.0);
+}
+
+TEST_CASE("StageHistogram records from several threads without losing samples") {
+  StageHistogram h;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&h, t] {
+      for (int i = 0; i < 10000; ++i) h.record(std::uint64_t(100 * (t + 1)));
+    });
+  }
+  for (auto& th : threads) th.join();
+  REQUIRE(h.count() == 40000);
+  REQUIRE(h.total_ns() == 10000ull * (100 + 200 + 300 + 400));
+  REQUIRE(h.max_ns() == 400);
+}
+
+TEST_CASE("StageProfiler names stages and scoped timers record into them") {
+  enum Stage : std::size_t { kA, kB };
+  StageProfiler p{"a", "b"};
+  REQUIRE(p.size() == 2);
+  REQUIRE(std::string(p.name(kB)) == "b");
+
+  {
+    ScopedStageTimer t(p, kA);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  REQUIRE(p.stage(kA).count() == 1);
+  REQUIRE(p.stage(kA).max_ns() >= 2000000);
+  REQUIRE(p.stage(kB).count() == 0);
+
+  StageStopwatch sw(p);
+  sw.lap(kB);
+  sw.lap(kB);
+  sw.total(kA);
+  REQUIRE(p.stage(kB).count() == 2);
+  REQUIRE(p.stage(kA).count() == 2);
+
+  p.reset();
+  REQUIRE(p.stage(kA).count() == 0);
+}
@@ -0,0 +1,71 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <random>
+#include <vector>
+
+#include <f1tm/race.hpp>
+#include <f1tm/race_batch.hpp>
+
+using Catch::Approx;
+using namespace f1tm;
+
+TEST_CASE("race_time_batch matches race_time_with_pits_under") {
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> nst(1, 4), laps(-2, 30);
+  std::uniform_real_distribution<double> base(-1.0, 95.0), deg(-0.05, 0.2);
+  std::uniform_real_distribution<double> pit(-1.0, 25.0), fac(-0.2, 1.2);
+
+  StrategyBatch batch(4);
+  std::vector<double> expected;
+  for (int s = 0; s < 500; ++s) {
+    const int n = nst(rng);
+    std::vector<StintParams> st;
+    std::vector<PitParams> pits;
+    std::vector<double> f;
+    for (int k = 0; k < n; ++k) st.push_back({laps(rng), base(rng), deg(rng)});
+    for (int k = 0; k + 1 < n; ++k) { pits.push_back({pit(rng), pit(rng)}); f.push_back(fac(rng)); }
+    REQUIRE(batch.add(st, pits, f));
+    expected.push_back(*race_time_with_pits_under(st, pits, f));
+  }
+
+  std::vector<double> out(batch.size());
+  REQUIRE(race_time_batch(batch, out));
+  for (std::size_t i = 0; i < out.size(); ++i) REQUIRE(out[i] == Approx(expected[i]).epsilon(1e-12));
+
+  // Chunked evaluation gives the same values
+  std::vector<double> part(100);
+  REQUIRE(race_time_batch(batch, 250, part));
+  for (std::size_t i = 0; i < part.size(); ++i) REQUIRE(part[i] == out[250 + i]);
+}
+
+TEST_CASE("StrategyBatch rejects malformed strategies and small outputs") {
+  StrategyBatch batch(2);
+  REQUIRE_FALSE(batch.add({}, {}, {}));
+  REQUIRE_FALSE(batch.add({{3, 90.0, 0.1}, {2, 91.0, 0.1}}, {}, {}));
+  REQUIRE_FALSE(batch.add({{1, 90, 0}, {1, 90, 0}, {1, 90, 0}}, {{2, 10}, {2, 10}}, {1.0, 1.0}));
+  REQUIRE(batch.size() == 0);
+
+  REQUIRE(batch.add({{3, 90.0, 0.2}, {2, 91.0, 0.1}}, {{2.5, 17.0}}, {0.5}));
+  std::vector<double> none;
+  REQUIRE_FALSE(race_time_batch(batch, none));
+  REQUIRE_FALSE(race_time_batch(batch, 1, std::span<double>(none.data(), 1)));
+}
+
+TEST_CASE("StrategyBatch columns can be filled directly") {
+  StrategyBatch batch(2);
+  batch.resize(3);
+  for (std::size_t i = 0; i < 3; ++i) {
+    batch.laps(0)[i] = int(10 + i);
+    batch.laps(1)[i] = int(20 - i);
+    batch.base_lap(0)[i] = batch.base_lap(1)[i] = 90.0;
+    batch.deg_per_lap(0)[i] = batch.deg_per_lap(1)[i] = 0.1;
+    batch.stationary(0)[i] = 2.0;
+    batch.lane(0)[i] = 18.0;
+    batch.lane_factor(0)[i] = 1.0;
+  }
+  std::vector<double> out(3);
+  REQUIRE(race_time_batch(batch, out));
+  // 30 laps at 90 s plus degradation of both stints plus one 20 s stop
+  REQUIRE(out[0] == Approx(30 * 90.0 + 0.1 * (10 * 9 + 20 * 19) / 2.0 + 20.0));
+  REQUIRE(out[2] == Approx(30 * 90.0 + 0.1 * (12 * 11 + 18 * 17) / 2.0 + 20.0));
+}
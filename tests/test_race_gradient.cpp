@@ -0,0 +1,110 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <vector>
+
+#include <f1tm/race.hpp>
+#include <f1tm/race_gradient.hpp>
+
+using Catch::Approx;
+using namespace f1tm;
+
+TEST_CASE("race_time_gradient matches finite differences") {
+  std::vector<StintParams> st{{20, 90.0, 0.2}, {37, 91.0, 0.05}};
+  std::vector<PitParams> pits{{2.4, 19.0}};
+  std::vector<double> f{0.6};
+  const auto g = race_time_gradient(st, pits, f);
+  REQUIRE(g.has_value());
+  REQUIRE(g->total == Approx(*race_time_with_pits_under(st, pits, f)));
+
+  const double h = 1e-4;
+  auto T = [&](auto mutate) {
+    auto s2 = st; auto p2 = pits; auto f2 = f;
+    mutate(s2, p2, f2);
+    return *race_time_with_pits_under(s2, p2, f2);
+  };
+  for (std::size_t i = 0; i < st.size(); ++i) {
+    const double db = (T([&](auto& s, auto&, auto&){ s[i].baseLap += h; }) - g->total) / h;
+    const double dd = (T([&](auto& s, auto&, auto&){ s[i].degradationPerLap += h; }) - g->total) / h;
+    REQUIRE(g->stints[i].d_base == Approx(db).epsilon(1e-4));
+    REQUIRE(g->stints[i].d_deg == Approx(dd).epsilon(1e-4));
+    // d_laps is the derivative of the continuous extension
+    const auto& s = st[i];
+    const double n = double(s.laps);
+    const double dn = (stint_time_continuous(n + h, s.baseLap, s.degradationPerLap) -
+                       stint_time_continuous(n - h, s.baseLap, s.degradationPerLap)) / (2 * h);
+    REQUIRE(g->stints[i].d_laps == Approx(dn).epsilon(1e-6));
+  }
+  REQUIRE(g->stops[0].d_stationary == 1.0);
+  REQUIRE(g->stops[0].d_lane == Approx(0.6));
+  REQUIRE(g->stops[0].d_lane_factor == Approx(19.0));
+
+  // Clamped factor: no sensitivity
+  const auto g2 = race_time_gradient(st, pits, {1.3});
+  REQUIRE(g2->stops[0].d_lane_factor == 0.0);
+  REQUIRE(g2->stops[0].d_lane == 1.0);
+  REQUIRE_FALSE(race_time_gradient(st, {}, {}).has_value());
+}
+
+// Exhaustive search over integer splits (reference).
+static double grid_best(int N, const std::vector<StintParams>& st, int lo, const std::vector<int>& hi,
+                        std::vector<int>& best) {
+  double best_t = 1e300;
+  std::vector<int> cur(st.size());
+  auto rec = [&](auto&& self, std::size_t i, int rem) -> void {
+    if (i + 1 == st.size()) {
+      if (rem < lo || (!hi.empty() && hi[i] > 0 && rem > hi[i])) return;
+      cur[i] = rem;
+      double t = 0.0;
+      for (std::size_t k = 0; k < st.size(); ++k) t += estimate_stint_time({cur[k], st[k].baseLap, st[k].degradationPerLap});
+      if (t < best_t) { best_t = t; best = cur; }
+      return;
+    }
+    for (int l = lo; l <= rem; ++l) {
+      if (!hi.empty() && hi[i] > 0 && l > hi[i]) break;
+      cur[i] = l;
+      self(self, i + 1, rem - l);
+    }
+  };
+  rec(rec, 0, N);
+  return best_t;
+}
+
+TEST_CASE("optimize_lap_split finds the integer optimum") {
+  const std::vector<StintParams> st{{0, 90.0, 0.20}, {0, 90.6, 0.09}, {0, 91.1, 0.05}, {0, 90.6, 0.0}};
+  const std::vector<PitParams> pits(3, {2.4, 19.0});
+  const std::vector<double> f(3, 1.0);
+  const double pit = 3 * 21.4;
+
+  SECTION("unbounded") {
+    const auto r = optimize_lap_split(57, st, pits, f);
+    REQUIRE(r.has_value());
+    std::vector<int> ref;
+    const double t = grid_best(57, st, 1, {}, ref);
+    REQUIRE(r->total_time == Approx(t + pit));
+    int sum = 0;
+    for (int l : r->laps) sum += l;
+    REQUIRE(sum == 57);
+    REQUIRE(r->newton_steps <= 5);
+  }
+  SECTION("with tyre-life caps") {
+    LapSplitOptions opt;
+    opt.min_stint_laps = 5;
+    opt.max_stint_laps = {12, 18, 25, 10};
+    const auto r = optimize_lap_split(57, st, pits, f, opt);
+    REQUIRE(r.has_value());
+    std::vector<int> ref;
+    const double t = grid_best(57, st, 5, opt.max_stint_laps, ref);
+    REQUIRE(r->total_time == Approx(t + pit));
+    for (std::size_t i = 0; i < 4; ++i) {
+      REQUIRE(r->laps[i] >= 5);
+      REQUIRE(r->laps[i] <= opt.max_stint_laps[i]);
+    }
+  }
+  SECTION("infeasible and invalid") {
+    LapSplitOptions opt;
+    opt.max_stint_laps = {10, 10, 10, 10};
+    REQUIRE_FALSE(optimize_lap_split(57, st, pits, f, opt).has_value());
+    REQUIRE_FALSE(optimize_lap_split(57, st, {}, {}).has_value());
+    REQUIRE_FALSE(optimize_lap_split(57, {{0, -1.0, 0.1}, {0, 90.0, 0.1}}, {{2, 10}}, {1.0}).has_value());
+  }
+}
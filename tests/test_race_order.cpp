@@ -0,0 +1,107 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <f1tm/race_order.hpp>
+
+using namespace f1tm;
+
+static CarPose car(CarId id, std::uint64_t lap, double s) {
+  CarPose c{};
+  c.id = id;
+  c.lap = lap;
+  c.s = s;
+  return c;
+}
+
+static std::vector<CarId> ids(const RaceOrder& o) {
+  std::vector<CarId> out;
+  for (std::size_t i = 0; i < o.size(); ++i) out.push_back(o[i].pose.id);
+  return out;
+}
+
+TEST_CASE("format_race_time and format_race_gap render whole milliseconds") {
+  char buf[32];
+  format_race_time(83.4567, buf, sizeof(buf));
+  REQUIRE(std::string(buf) == "1:23.457");
+  format_race_time(9.05, buf, sizeof(buf));
+  REQUIRE(std::string(buf) == "9.050");
+  format_race_time(59.9996, buf, sizeof(buf)); // rounds into the next minute
+  REQUIRE(std::string(buf) == "1:00.000");
+  format_race_time(-1.0, buf, sizeof(buf));
+  REQUIRE(std::string(buf) == "--");
+  format_race_time(std::nan(""), buf, sizeof(buf));
+  REQUIRE(std::string(buf) == "--");
+  format_race_gap(1.2, buf, sizeof(buf));
+  REQUIRE(std::string(buf) == "+1.200");
+  REQUIRE(format_race_time(83.4567, buf, 4) == 3); // truncates like snprintf
+  REQUIRE(std::string(buf) == "1:2");
+}
+
+TEST_CASE("RaceOrder sorts by lap then distance and tracks overtakes") {
+  std::vector<CarPose> cars{car(0, 1, 100.0), car(1, 2, 10.0), car(2, 1, 500.0)};
+  RaceOrder o;
+  o.update(cars);
+  REQUIRE(ids(o) == std::vector<CarId>{1, 2, 0});
+  REQUIRE(o.leader().id == 1);
+  REQUIRE(std::string(o[0].pos) == " 1");
+  REQUIRE(std::string(o[2].id) == "0");
+
+  cars[0].s = 600.0; // car 0 passes car 2
+  o.update(cars);
+  REQUIRE(ids(o) == std::vector<CarId>{1, 0, 2});
+  REQUIRE(std::string(o[1].id) == "0");
+  REQUIRE(std::string(o[1].pos) == " 2");
+
+  const auto poses = o.poses();
+  REQUIRE(poses.size() == 3);
+  REQUIRE(poses[2].id == 2);
+}
+
+TEST_CASE("RaceOrder re-formats only cells whose shown value changed") {
+  std::vector<CarPose> cars;
+  for (CarId i = 0; i < 20; ++i) {
+    auto c = car(i, 3, 1000.0 - i);
+    c.gap_to_leader_s = 0.1 * i;
+    c.last_lap_time = 90.0 + i;
+    cars.push_back(c);
+  }
+  RaceOrder o;
+  o.update(cars);
+  const auto after_first = o.formatted_cells();
+
+  o.update(cars); // nothing moved
+  REQUIRE(o.formatted_cells() == after_first);
+
+  for (auto& c : cars) c.s += 0.5; // everyone moves, no overtakes, same shown values
+  o.update(cars);
+  REQUIRE(o.formatted_cells() == after_first);
+
+  cars[5].gap_to_leader_s += 0.0004; // below a shown millisecond
+  o.update(cars);
+  REQUIRE(o.formatted_cells() == after_first);
+
+  cars[5].gap_to_leader_s += 0.002;
+  o.update(cars);
+  REQUIRE(o.formatted_cells() == after_first + 1);
+  REQUIRE(std::string(o[5].gap) == "+0.502");
+}
+
+TEST_CASE("RaceOrder rebuilds when the car set changes and reports sector minima") {
+  std::vector<CarPose> cars{car(0, 1, 10.0), car(1, 1, 20.0)};
+  cars[0].s1_last = 30.5;
+  cars[1].s1_last = 29.75;
+  RaceOrder o;
+  o.update(cars);
+  REQUIRE(o.sector_min(1) == 29.75);
+  REQUIRE(o.sector_min(2) == -1.0);
+
+  cars.push_back(car(7, 2, 0.0));
+  o.update(cars);
+  REQUIRE(ids(o) == std::vector<CarId>{7, 1, 0});
+  REQUIRE(std::string(o[0].id) == "7");
+
+  o.update({});
+  REQUIRE(o.empty());
+}
@@ -0,0 +1,225 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#if !defined(_WIN32)
+  #include <sys/stat.h>
+#endif
+
+#include <f1tm/recorder.hpp>
+#include <f1tm/rec_format.hpp>
+#include <f1tm/replay.hpp>
+#include <f1tm/spsc_ring.hpp>
+
+using Catch::Approx;
+using namespace f1tm;
+
+static SimSnapshot make_tick(std::uint64_t tick, std::size_t cars) {
+  SimSnapshot s{};
+  s.tick = tick;
+  s.sim_time = double(tick) / 240.0;
+  for (std::size_t i = 0; i < cars; ++i) {
+    CarPose cp{};
+    cp.id = CarId(i);
+    cp.s = 60.0 * s.sim_time + 9.0 * double(i);
+    cp.x = 100.0 + cp.s * 0.5;
+    cp.y = -20.0 - cp.s * 0.25;
+    cp.heading_rad = 0.001 * double(tick);
+    cp.speed_mps = 60.0 + double(i);
+    cp.lap = tick / 100;
+    s.cars.push_back(cp);
+  }
+  return s;
+}
+
+TEST_CASE("SpscRing is a bounded FIFO") {
+  SpscRing<int> ring(3);                       // rounds up to 4
+  REQUIRE(ring.capacity() == 4);
+  for (int i = 0; i < 4; ++i) REQUIRE(ring.try_push(i));
+  REQUIRE_FALSE(ring.try_push(99));
+  REQUIRE(ring.write_available() == 0);
+  int v = -1;
+  REQUIRE(ring.try_pop(v));
+  REQUIRE(v == 0);
+  REQUIRE(ring.try_push(4));
+  for (int want = 1; want <= 4; ++want) { REQUIRE(ring.try_pop(v)); REQUIRE(v == want); }
+  REQUIRE_FALSE(ring.try_pop(v));
+}
+
+TEST_CASE("Frame and event codecs round-trip within quantization") {
+  std::vector<RecordRow> rows;
+  for (std::uint64_t t = 0; t < 50; ++t) {
+    const auto s = make_tick(t, 5);
+    for (const auto& c : s.cars) {
+      rows.push_back(RecordRow{s.sim_time, s.tick, c.id, std::uint32_t(c.lap),
+                               c.s, c.x, c.y, c.heading_rad, c.speed_mps});
+    }
+  }
+  std::vector<std::uint8_t> buf;
+  rec_encode_frames(rows.data(), rows.size(), buf);
+  REQUIRE(buf.size() < rows.size() * sizeof(RecordRow) / 4); // compresses well
+
+  std::vector<RecordRow> back;
+  REQUIRE(rec_decode_frames(buf.data(), buf.size(), std::uint32_t(rows.size()), back));
+  REQUIRE(back.size() == rows.size());
+  for (std::size_t i = 0; i < rows.size(); ++i) {
+    REQUIRE(back[i].id == rows[i].id);
+    REQUIRE(back[i].tick == rows[i].tick);
+    REQUIRE(back[i].lap == rows[i].lap);
+    REQUIRE(back[i].t == Approx(rows[i].t).margin(1e-6));
+    REQUIRE(back[i].x == Approx(rows[i].x).margin(1e-3));
+    REQUIRE(back[i].s == Approx(rows[i].s).margin(1e-3));
+    REQUIRE(back[i].heading_rad == Approx(rows[i].heading_rad).margin(1e-5));
+  }
+  // Truncated payload is rejected
+  REQUIRE_FALSE(rec_decode_frames(buf.data(), buf.size() - 1, std::uint32_t(rows.size()), back));
+
+  std::vector<RecordEvent> ev{ {1.5, 3, RecordEventKind::LapCompleted, 81.234},
+                               {2.0, 1, RecordEventKind::LapCompleted, 80.001} };
+  rec_encode_events(ev.data(), ev.size(), buf);
+  std::vector<RecordEvent> ev_back;
+  REQUIRE(rec_decode_events(buf.data(), buf.size(), 2, ev_back));
+  REQUIRE(ev_back[1].id == 1);
+  REQUIRE(ev_back[1].value == Approx(80.001));
+}
+
+TEST_CASE("Recorder writes whole ticks in blocks on its own thread") {
+  const auto path = (std::filesystem::temp_directory_path() / "f1tm_test_recorder.f1rec").string();
+  RecorderConfig cfg{};
+  cfg.block_rows = 64;
+  {
+    Recorder rec(cfg);
+    REQUIRE(rec.start(path));
+    REQUIRE_FALSE(rec.start(path));            // already running
+    for (std::uint64_t t = 1; t <= 300; ++t) {
+      while (!rec.record(make_tick(t, 7))) {}  // test only: retry if the ring is full
+    }
+    REQUIRE(rec.record_event(RecordEvent{1.0, 2, RecordEventKind::LapCompleted, 90.0}));
+    rec.stop();
+    REQUIRE_FALSE(rec.recording());
+    rec.join();
+    REQUIRE_FALSE(rec.writing());
+    REQUIRE(rec.stats().rows_written.load() == 300 * 7);
+    REQUIRE(rec.stats().events_written.load() == 1);
+    REQUIRE(rec.stats().blocks_written.load() > 2);
+    REQUIRE(rec.stats().bytes_written.load() == std::filesystem::file_size(path));
+  }
+
+  // Scan the file: every frame block holds complete ticks
+  std::ifstream f(path, std::ios::binary);
+  std::vector<char> data((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+  REQUIRE(data.size() > sizeof(RecFileHeader));
+  REQUIRE(std::memcmp(data.data(), kRecMagic, 8) == 0);
+  std::size_t off = sizeof(RecFileHeader), frame_rows = 0;
+  while (off < data.size()) {
+    RecBlockHeader bh{};
+    std::memcpy(&bh, data.data() + off, sizeof(bh));
+    REQUIRE(bh.magic == kRecBlockMagic);
+    off += sizeof(bh);
+    if (bh.kind == std::uint32_t(RecBlockKind::Frames)) {
+      std::vector<RecordRow> rows;
+      REQUIRE(rec_decode_frames(reinterpret_cast<const std::uint8_t*>(data.data() + off),
+                                bh.bytes, bh.rows, rows));
+      REQUIRE(rows.size() % 7 == 0);
+      REQUIRE(rows.front().t == Approx(bh.t_first).margin(1e-6));
+      frame_rows += rows.size();
+    }
+    off += bh.bytes;
+  }
+  REQUIRE(frame_rows == 300 * 7);
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("record_lap_events records timed laps only") {
+  const auto path = (std::filesystem::temp_directory_path() / "f1tm_test_lap_events.f1rec").string();
+  SimServer sim;
+  sim.track.radius_m = 50.0;
+  const double C = sim.track.circumference_m();
+  const double v = 47.0;
+  sim.add_car(4, v, 0.0);
+  sim.add_car(9, v * 0.5, 0.0);  // crosses the lap line once: untimed, no event
+  TelemetrySink telem;
+  std::vector<std::uint64_t> lap_seen;
+  const double dt = 1.0 / 240.0;
+  double t = 0.0;
+  telem.update(sim, t);
+
+  std::size_t emitted = 0;
+  {
+    Recorder rec;
+    REQUIRE(rec.start(path));
+    const int steps = int(3.2 * C / v / dt);
+    for (int i = 0; i < steps; ++i) {
+      sim.step(dt);
+      t += dt;
+      telem.update(sim, t);
+      rec.record(make_tick(std::uint64_t(i + 1), 2));  // frames, so a replay can open it
+      emitted += record_lap_events(rec, sim, telem, lap_seen, t);
+    }
+    rec.stop();
+    rec.join();
+  }
+  REQUIRE(emitted == 2);  // car 4, laps 2 and 3; never a -1 s first lap
+
+  {
+    ReplayLog log;
+    REQUIRE(log.open(path));
+    REQUIRE(log.events().size() == 2);
+    for (std::size_t k = 0; k < 2; ++k) {
+      const auto& e = log.events()[k];
+      REQUIRE(e.id == 4);
+      REQUIRE(e.value == Approx(C / v).margin(1e-5));
+      REQUIRE(e.t == Approx(double(k + 2) * C / v).margin(1e-5));
+    }
+  }
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("Recorder reports a file it cannot open") {
+  Recorder rec;
+  const auto path = (std::filesystem::temp_directory_path() / "f1tm_no_such_dir" / "x.f1rec").string();
+  REQUIRE(rec.start(path));   // the writer opens the file, not the caller
+  rec.join();
+  REQUIRE(rec.stats().open_failures.load() == 1);
+  REQUIRE_FALSE(rec.recording());
+  REQUIRE_FALSE(rec.record(make_tick(1, 2)));
+}
+
+#if !defined(_WIN32)
+TEST_CASE("Recorder start and stop return without waiting on the file") {
+  // Opening a FIFO for writing blocks until a reader opens it, so the writer stays
+  // stuck before its first drain for as long as this test wants.
+  const auto path = (std::filesystem::temp_directory_path() / "f1tm_test_recorder.fifo").string();
+  std::filesystem::remove(path);
+  REQUIRE(::mkfifo(path.c_str(), 0600) == 0);
+
+  RecorderConfig cfg{};
+  cfg.ring_rows = 2048;
+  cfg.block_rows = 64;
+  Recorder rec(cfg);
+  REQUIRE(rec.start(path));
+  std::uint64_t ticks = 0;
+  while (rec.record(make_tick(ticks + 1, 20))) ++ticks;  // fill the ring
+  REQUIRE(ticks == 2048 / 20);
+  REQUIRE(rec.stats().frames_dropped.load() == 1);
+
+  rec.stop();                                   // full ring, nothing drained yet
+  REQUIRE_FALSE(rec.recording());
+  REQUIRE(rec.writing());
+  REQUIRE(rec.stats().rows_written.load() == 0);
+  REQUIRE_FALSE(rec.start(path));               // previous session still being written
+
+  // Reading unblocks the writer, which finishes the stopped session on its own.
+  std::ifstream f(path, std::ios::binary);
+  std::vector<char> data((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+  rec.join();
+  REQUIRE_FALSE(rec.writing());
+  REQUIRE(rec.stats().rows_written.load() == ticks * 20);
+  REQUIRE(data.size() == rec.stats().bytes_written.load());
+  REQUIRE(std::memcmp(data.data(), kRecMagic, 8) == 0);
+  std::filesystem::remove(path);
+}
+#endif
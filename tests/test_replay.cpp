@@ -0,0 +1,116 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <f1tm/recorder.hpp>
+#include <f1tm/replay.hpp>
+
+using Catch::Approx;
+using namespace f1tm;
+
+// Records `ticks` ticks of `cars` cars at 240 Hz; car i sits at s = tick + i.
+static std::string record_fixture(const char* name, std::uint64_t ticks, std::size_t cars) {
+  const auto path = (std::filesystem::temp_directory_path() / name).string();
+  RecorderConfig cfg{};
+  cfg.block_rows = 50;
+  Recorder rec(cfg);
+  REQUIRE(rec.start(path, /*track_id*/ 3));
+  for (std::uint64_t t = 1; t <= ticks; ++t) {
+    SimSnapshot s{};
+    s.tick = t;
+    s.sim_time = double(t) / 240.0;
+    for (std::size_t i = 0; i < cars; ++i) {
+      CarPose cp{};
+      cp.id = CarId(10 + i);
+      cp.s = double(t) + double(i);
+      cp.x = cp.s;
+      s.cars.push_back(cp);
+    }
+    while (!rec.record(s)) {}
+    if (t % 240 == 0) rec.record_event(RecordEvent{s.sim_time, 10, RecordEventKind::LapCompleted, 1.0});
+  }
+  rec.stop();
+  rec.join();
+  return path;
+}
+
+TEST_CASE("ReplayLog indexes blocks and seeks by sim_time") {
+  const auto path = record_fixture("f1tm_test_replay.f1rec", 1000, 4);
+  ReplayLog log;
+  REQUIRE(log.open(path));
+  REQUIRE(log.track_id() == 3);
+  REQUIRE(log.blocks().size() > 10);
+  REQUIRE(log.t_begin() == Approx(1.0 / 240.0));
+  REQUIRE(log.t_end() == Approx(1000.0 / 240.0));
+  REQUIRE(log.events().size() == 4);
+
+  SimSnapshot out{};
+  SECTION("exact tick times and in-between times resolve to the latest tick") {
+    for (std::uint64_t t : {1ull, 49ull, 500ull, 777ull, 1000ull}) {
+      REQUIRE(log.frame_at(double(t) / 240.0, out));
+      REQUIRE(out.tick == t);
+      REQUIRE(out.cars.size() == 4);
+      REQUIRE(out.cars[2].id == 12);
+      REQUIRE(out.cars[2].s == Approx(double(t) + 2.0));
+      REQUIRE(log.frame_at((double(t) + 0.5) / 240.0, out));
+      REQUIRE(out.tick == t);
+    }
+  }
+  SECTION("out-of-range times clamp") {
+    REQUIRE(log.frame_at(-5.0, out));
+    REQUIRE(out.tick == 1);
+    REQUIRE(log.frame_at(1e9, out));
+    REQUIRE(out.tick == 1000);
+  }
+  SECTION("backwards seeks across blocks") {
+    REQUIRE(log.frame_at(900.0 / 240.0, out));
+    REQUIRE(log.frame_at(3.0 / 240.0, out));
+    REQUIRE(out.tick == 3);
+    REQUIRE(log.tick_at(600.0 / 240.0) == 600);
+  }
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("ReplaySource behaves like a SnapshotBuffer consumer") {
+  const auto path = record_fixture("f1tm_test_replay_src.f1rec", 480, 2);
+  ReplayLog log;
+  REQUIRE(log.open(path));
+  ReplaySource src(log);
+  std::uint64_t cursor = 0;
+  SimSnapshot out{};
+
+  REQUIRE(src.try_consume_latest(cursor, out));
+  REQUIRE(out.tick == 1);
+  REQUIRE_FALSE(src.try_consume_latest(cursor, out)); // nothing new
+
+  src.set_warp(2.0);
+  src.advance(0.5);                                     // +1 s of sim time
+  REQUIRE(src.try_consume_latest(cursor, out));
+  REQUIRE(out.sim_time == Approx(1.0 / 240.0 + 1.0).margin(1.0 / 240.0));
+
+  src.set_paused(true);
+  src.advance(10.0);
+  REQUIRE_FALSE(src.try_consume_latest(cursor, out));
+
+  src.seek(0.5);
+  REQUIRE(src.try_consume_latest(cursor, out));
+  REQUIRE(out.tick == 120);
+
+  src.set_paused(false);
+  src.advance(100.0);
+  REQUIRE(src.at_end());
+  REQUIRE(src.try_consume_latest(cursor, out));
+  REQUIRE(out.tick == 480);
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("ReplayLog rejects missing and foreign files") {
+  ReplayLog log;
+  REQUIRE_FALSE(log.open("does_not_exist.f1rec"));
+  const auto path = (std::filesystem::temp_directory_path() / "f1tm_test_not_rec.bin").string();
+  { std::ofstream f(path, std::ios::binary); f << "definitely not a recording"; }
+  REQUIRE_FALSE(log.open(path));
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,118 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <vector>
+
+#include <f1tm/monte_carlo.hpp>
+#include <f1tm/sampling.hpp>
+#include <f1tm/track.hpp>
+
+using Catch::Approx;
+using namespace f1tm;
+
+TEST_CASE("SobolSequence starts with the reference points") {
+  const SobolSequence s;
+  const double d0[] = {0.0, 0.5, 0.75, 0.25};
+  const double d1[] = {0.0, 0.5, 0.25, 0.75};
+  for (std::uint64_t n = 0; n < 4; ++n) {
+    REQUIRE(s.point(n, 0) == d0[n]);
+    REQUIRE(s.point(n, 1) == d1[n]);
+  }
+}
+
+TEST_CASE("SobolSequence is stratified in every dimension") {
+  const SobolSequence s;
+  constexpr std::uint64_t M = 256;
+  for (std::size_t d = 0; d < SobolSequence::kMaxDims; ++d) {
+    std::vector<int> cells(M, 0);
+    for (std::uint64_t n = 0; n < M; ++n) ++cells[std::size_t(s.point(n, d) * M)];
+    for (int c : cells) REQUIRE(c == 1);
+  }
+}
+
+TEST_CASE("ScenarioSampler antithetic partners mirror each other") {
+  const ScenarioSampler a(SamplingMode::Antithetic, CounterRng(4));
+  for (std::uint64_t m = 0; m < 100; ++m) {
+    REQUIRE(a.uniform(2 * m, 1) + a.uniform(2 * m + 1, 1) == Approx(1.0));
+  }
+  const ScenarioSampler q1(SamplingMode::Sobol, CounterRng(1));
+  const ScenarioSampler q2(SamplingMode::Sobol, CounterRng(2));
+  REQUIRE(q1.uniform(0, 0) != q2.uniform(0, 0)); // different digital shifts
+  REQUIRE(q1.uniform(3, SobolSequence::kMaxDims) < 1.0); // past the table: independent draws
+}
+
+static const std::vector<StintParams> kOneStop{{20, 90.0, 0.20}, {37, 91.0, 0.05}};
+static const std::vector<StintParams> kTwoStop{{18, 90.0, 0.20}, {20, 90.6, 0.09}, {19, 90.6, 0.09}};
+
+TEST_CASE("compare_strategies converges on the analytic delta") {
+  auto track = track_by_key("Bahrain");
+  REQUIRE(track.has_value());
+  const double ef = 0.2 * track->sc_lane_factor + 0.1 * track->vsc_lane_factor + 0.7;
+  auto fixed = [&](const std::vector<StintParams>& st) {
+    double t = 0.0;
+    for (const auto& s : st) t += estimate_stint_time(s);
+    return t + double(st.size() - 1) * (track->pit_stationary_s + track->pit_lane_delta_s * ef);
+  };
+  const double expect = fixed(kOneStop) - fixed(kTwoStop);
+
+  for (auto mode : {SamplingMode::Uniform, SamplingMode::Antithetic, SamplingMode::Sobol}) {
+    PairedComparisonOptions opt;
+    opt.p_sc = 0.2;
+    opt.p_vsc = 0.1;
+    opt.sampling = mode;
+    opt.ci_half_width = 0.05;
+    const auto r = compare_strategies(kOneStop, kTwoStop, *track, opt);
+    REQUIRE(r.has_value());
+    REQUIRE(r->converged);
+    REQUIRE(r->ci_half_width <= 0.05);
+    REQUIRE(r->mean_delta == Approx(expect).margin(3.0 * r->ci_half_width));
+    const auto again = compare_strategies(kOneStop, kTwoStop, *track, opt);
+    REQUIRE(again->mean_delta == r->mean_delta);
+  }
+}
+
+TEST_CASE("compare_strategies: Sobol needs far fewer scenarios than uniform") {
+  auto track = track_by_key("Bahrain");
+  REQUIRE(track.has_value());
+  PairedComparisonOptions opt;
+  opt.p_sc = 0.2;
+  opt.p_vsc = 0.1;
+  opt.ci_half_width = 0.02;
+  opt.sampling = SamplingMode::Uniform;
+  const auto u = compare_strategies(kOneStop, kTwoStop, *track, opt);
+  opt.sampling = SamplingMode::Sobol;
+  const auto q = compare_strategies(kOneStop, kTwoStop, *track, opt);
+  REQUIRE(u->converged);
+  REQUIRE(q->converged);
+  REQUIRE(q->scenarios * 10 <= u->scenarios);
+}
+
+TEST_CASE("compare_strategies stops at max_scenarios and validates input") {
+  auto track = track_by_key("Bahrain");
+  REQUIRE(track.has_value());
+  PairedComparisonOptions opt;
+  opt.p_sc = 0.3;
+  opt.ci_half_width = 1e-6;
+  opt.sampling = SamplingMode::Uniform;
+  opt.max_scenarios = 5000;
+  const auto r = compare_strategies(kOneStop, kTwoStop, *track, opt);
+  REQUIRE(r.has_value());
+  REQUIRE_FALSE(r->converged);
+  REQUIRE(r->scenarios <= 5000);
+  REQUIRE_FALSE(compare_strategies({}, kTwoStop, *track).has_value());
+}
+
+TEST_CASE("simulate_strategy_outcomes supports Sobol sampling") {
+  auto track = track_by_key("Bahrain");
+  REQUIRE(track.has_value());
+  MonteCarloOptions opt;
+  opt.scenarios = 4096;
+  opt.p_sc = 0.2;
+  opt.p_vsc = 0.1;
+  opt.sampling = SamplingMode::Sobol;
+  const auto r = simulate_strategy_outcomes({kOneStop}, *track, opt);
+  REQUIRE(r.has_value());
+  const double ef = 0.2 * track->sc_lane_factor + 0.1 * track->vsc_lane_factor + 0.7;
+  const double expect = estimate_stint_time(kOneStop[0]) + estimate_stint_time(kOneStop[1]) +
+                        track->pit_stationary_s + track->pit_lane_delta_s * ef;
+  REQUIRE(r->outcomes[0].mean == Approx(expect).margin(0.01));
+}
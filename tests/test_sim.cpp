@@ -1,6 +1,9 @@
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <cmath>
 #include <f1tm/sim.hpp>
 
+using Catch::Approx;
 using namespace f1tm;
 
 TEST_CASE("SimServer advances along a circle and wraps laps (single car via add_car)") {
@@ -25,3 +28,23 @@ TEST_CASE("SimServer advances along a circle and wraps laps (single car via add_
   REQUIRE(car0->s >= 0.0);
   REQUIRE(car0->s < C);
 }
+
+TEST_CASE("SimServer samples per-car lateral offset") {
+  SimServer sim;
+  sim.track.radius_m = 10.0;
+  sim.add_car(0, 10.0, 0.0, 0, /*lateral0*/ 0.0);
+  sim.add_car(1, 10.0, 0.0, 0, /*lateral0*/ 2.0);   // left of CCW travel = inside
+
+  double x0, y0, h0, x1, y1, h1;
+  sim.sample_pose_index(0, x0, y0, h0);
+  sim.sample_pose_index(1, x1, y1, h1);
+  REQUIRE(std::hypot(x0, y0) == Approx(10.0));
+  REQUIRE(std::hypot(x1, y1) == Approx(8.0));
+  REQUIRE(h0 == Approx(h1));
+
+  // Same side-by-side result on a path track
+  sim.set_track_path(TrackPath::Stadium(100.0, 30.0));
+  sim.sample_pose_index(0, x0, y0, h0);
+  sim.sample_pose_index(1, x1, y1, h1);
+  REQUIRE(std::hypot(x1 - x0, y1 - y0) == Approx(2.0));
+}
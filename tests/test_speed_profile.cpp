@@ -0,0 +1,66 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <algorithm>
+#include <cmath>
+
+#include <f1tm/speed_profile.hpp>
+#include <f1tm/sim.hpp>
+
+using Catch::Approx;
+using namespace f1tm;
+
+TEST_CASE("SpeedProfile derives corner and straight speeds from curvature") {
+  const auto path = TrackPath::Stadium(/*straight*/ 600.0, /*radius*/ 80.0, 24);
+  SpeedProfileParams prm{};
+  const auto sp = SpeedProfile::build(path, prm);
+  REQUIRE_FALSE(sp.empty());
+  REQUIRE(sp.length() == Approx(path.length()));
+
+  const auto& v = sp.speeds();
+  const auto [vmin, vmax] = std::minmax_element(v.begin(), v.end());
+
+  SECTION("corner speed follows sqrt(a_lat * R), straights reach v_max") {
+    REQUIRE(*vmin == Approx(std::sqrt(prm.a_lat_mps2 * 80.0)).epsilon(0.05));
+    REQUIRE(*vmax == Approx(prm.v_max_mps));
+  }
+  SECTION("neighbouring cells respect acceleration and braking limits") {
+    const double ds = sp.length() / double(sp.size());
+    const double a = std::max(prm.a_accel_mps2, prm.a_brake_mps2);
+    for (std::size_t i = 0; i < v.size(); ++i) {
+      const double vn = v[(i + 1) % v.size()];
+      REQUIRE(std::fabs(vn * vn - v[i] * v[i]) <= 2.0 * a * ds + 1e-6);
+    }
+  }
+  SECTION("lap time lies between the flat-out and all-corner bounds") {
+    REQUIRE(sp.lap_time() > path.length() / prm.v_max_mps);
+    REQUIRE(sp.lap_time() < path.length() / *vmin);
+  }
+  SECTION("speed_at wraps s") {
+    REQUIRE(sp.speed_at(10.0) == Approx(sp.speed_at(10.0 + sp.length())));
+    REQUIRE(sp.speed_at(-5.0) == Approx(sp.speed_at(sp.length() - 5.0)));
+  }
+}
+
+TEST_CASE("SimServer drives cars from the speed profile scaled by perf") {
+  SimServer sim;
+  sim.set_track_path(TrackPath::Stadium(250.0, 80.0));
+  sim.enable_speed_profile();
+  REQUIRE_FALSE(sim.speed_profile().empty());
+
+  CarState fast; fast.id = 0; fast.perf = 1.0;
+  CarState slow; slow.id = 1; slow.perf = 0.9;
+  sim.add_car(fast);
+  sim.add_car(slow);
+
+  const double dt = 1.0 / 240.0;
+  const double expected = sim.speed_profile().speed_at(0.0);
+  sim.step(dt);
+  REQUIRE(sim.car_by_index(0)->speed_mps == Approx(expected));
+  REQUIRE(sim.car_by_index(1)->speed_mps == Approx(0.9 * expected));
+
+  // One reference lap at perf 1.0 takes about lap_time()
+  double t = dt;
+  while (sim.car_by_index(0)->laps == 0) { sim.step(dt); t += dt; }
+  REQUIRE(sim.car_by_index(1)->laps == 0);
+  REQUIRE(t == Approx(sim.speed_profile().lap_time()).epsilon(0.01));
+}
@@ -0,0 +1,56 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <f1tm/stats.hpp>
+
+using Catch::Approx;
+using namespace f1tm;
+
+TEST_CASE("RunningStats matches two-pass mean and variance") {
+  RunningStats rs;
+  REQUIRE(rs.count() == 0);
+  REQUIRE(rs.mean() == 0.0);
+
+  const std::vector<double> xs{ 91.2, 90.8, 92.5, 90.1, 95.0, 90.9 };
+  for (double x : xs) rs.add(x);
+
+  double mean = 0.0;
+  for (double x : xs) mean += x;
+  mean /= double(xs.size());
+  double var = 0.0;
+  for (double x : xs) var += (x - mean) * (x - mean);
+  var /= double(xs.size() - 1);
+
+  REQUIRE(rs.count() == xs.size());
+  REQUIRE(rs.mean() == Approx(mean));
+  REQUIRE(rs.variance() == Approx(var));
+  REQUIRE(rs.stddev() == Approx(std::sqrt(var)));
+  REQUIRE(rs.min() == Approx(90.1));
+  REQUIRE(rs.max() == Approx(95.0));
+  REQUIRE(rs.sum() == Approx(mean * double(xs.size())));
+}
+
+TEST_CASE("P2Quantile estimates quantiles in constant memory") {
+  SECTION("exact for fewer than five samples") {
+    P2Quantile med(0.5);
+    med.add(3.0); med.add(1.0); med.add(2.0);
+    REQUIRE(med.value() == Approx(2.0));
+  }
+  SECTION("close to the true quantile on a long stream") {
+    std::mt19937 rng(42);
+    std::normal_distribution<double> lap(90.0, 0.8);
+    P2Quantile p50(0.5), p90(0.9);
+    std::vector<double> all;
+    for (int i = 0; i < 5000; ++i) {
+      const double x = lap(rng);
+      p50.add(x); p90.add(x); all.push_back(x);
+    }
+    std::sort(all.begin(), all.end());
+    REQUIRE(p50.value() == Approx(all[2500]).margin(0.05));
+    REQUIRE(p90.value() == Approx(all[4500]).margin(0.1));
+  }
+}
@@ -0,0 +1,112 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <f1tm/race.hpp>
+#include <f1tm/strategy.hpp>
+#include <f1tm/track.hpp>
+
+using Catch::Approx;
+using namespace f1tm;
+
+static const std::vector<Compound> kCompounds{
+  {"S", 90.0, 0.20, 0},
+  {"M", 90.6, 0.09, 0},
+  {"H", 91.1, 0.05, 0},
+};
+
+// All ordered stint sequences, deduplicated by stint multiset; sorted totals.
+static std::vector<double> brute_force(int laps, const Track& track, const std::vector<Compound>& cs,
+                                       int max_stops) {
+  const double pit = track.pit_stationary_s + track.pit_lane_delta_s;
+  std::vector<std::vector<std::pair<std::size_t, int>>> seen;
+  std::vector<double> totals;
+  std::vector<std::pair<std::size_t, int>> cur;
+  std::function<void(int)> rec = [&](int rem) {
+    if (rem == 0) {
+      unsigned mask = 0;
+      for (auto& s : cur) mask |= 1u << s.first;
+      if ((mask & (mask - 1)) == 0) return;
+      auto key = cur;
+      std::sort(key.begin(), key.end());
+      if (std::find(seen.begin(), seen.end(), key) != seen.end()) return;
+      seen.push_back(key);
+      double t = pit * double(cur.size() - 1);
+      for (auto& s : cur) t += estimate_stint_time({s.second, cs[s.first].baseLap, cs[s.first].degradationPerLap});
+      totals.push_back(t);
+      return;
+    }
+    if (int(cur.size()) > max_stops) return;
+    for (std::size_t c = 0; c < cs.size(); ++c) {
+      for (int L = 1; L <= rem; ++L) { cur.push_back({c, L}); rec(rem - L); cur.pop_back(); }
+    }
+  };
+  rec(laps);
+  std::sort(totals.begin(), totals.end());
+  return totals;
+}
+
+TEST_CASE("optimize_pit_strategy matches brute force on a short race") {
+  auto track = track_by_key("Bahrain");
+  REQUIRE(track.has_value());
+  StrategySearchOptions opt;
+  opt.max_stops = 2;
+  opt.top_k = 8;
+  const auto res = optimize_pit_strategy(12, *track, kCompounds, opt);
+  const auto ref = brute_force(12, *track, kCompounds, 2);
+  REQUIRE(res.size() == 8);
+  for (std::size_t i = 0; i < res.size(); ++i) REQUIRE(res[i].total_time == Approx(ref[i]));
+}
+
+TEST_CASE("optimize_pit_strategy plans agree with race_time_with_track") {
+  auto track = track_by_key("Bahrain");
+  REQUIRE(track.has_value());
+  const auto res = optimize_pit_strategy(57, *track, kCompounds);
+  REQUIRE(res.size() == 5);
+  for (std::size_t i = 0; i < res.size(); ++i) {
+    const auto& s = res[i];
+    if (i > 0) REQUIRE(s.total_time >= res[i - 1].total_time);
+    int laps = 0;
+    unsigned mask = 0;
+    for (const auto& st : s.stints) { laps += st.laps; mask |= 1u << st.compound; }
+    REQUIRE(laps == 57);
+    REQUIRE((mask & (mask - 1)) != 0);
+    REQUIRE(s.stops() <= 3);
+    const std::vector<std::string> green(std::size_t(s.stops()), "GREEN");
+    auto t = race_time_with_track(strategy_stints(s, kCompounds), *track, green);
+    REQUIRE(t.has_value());
+    REQUIRE(*t == Approx(s.total_time));
+  }
+}
+
+TEST_CASE("optimize_pit_strategy honours tyre life and stop limits") {
+  auto track = track_by_key("Bahrain");
+  REQUIRE(track.has_value());
+  auto cs = kCompounds;
+  for (auto& c : cs) c.maxLaps = 25;
+  StrategySearchOptions opt;
+  opt.max_stops = 2;
+  opt.top_k = 3;
+  const auto res = optimize_pit_strategy(70, *track, cs, opt);
+  REQUIRE_FALSE(res.empty());
+  for (const auto& s : res) {
+    REQUIRE(s.stops() == 2);
+    for (const auto& st : s.stints) REQUIRE(st.laps <= 25);
+  }
+  opt.max_stops = 1; // 50 laps max: infeasible
+  REQUIRE(optimize_pit_strategy(70, *track, cs, opt).empty());
+}
+
+TEST_CASE("optimize_pit_strategy rejects invalid input") {
+  auto track = track_by_key("Bahrain");
+  REQUIRE(track.has_value());
+  REQUIRE(optimize_pit_strategy(0, *track, kCompounds).empty());
+  REQUIRE(optimize_pit_strategy(50, *track, {}).empty());
+  REQUIRE(optimize_pit_strategy(50, *track, {{"X", -1.0, 0.1, 0}, {"Y", 90.0, 0.1, 0}}).empty());
+  StrategySearchOptions opt;
+  opt.top_k = 0;
+  REQUIRE(optimize_pit_strategy(50, *track, kCompounds, opt).empty());
+}
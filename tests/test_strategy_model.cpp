@@ -0,0 +1,83 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <random>
+#include <vector>
+
+#include <f1tm/race.hpp>
+#include <f1tm/strategy_model.hpp>
+
+using Catch::Approx;
+using namespace f1tm;
+
+static double rescore(const StrategyModel& m) {
+  std::vector<double> f;
+  for (std::size_t i = 0; i < m.stop_count(); ++i) f.push_back(m.lane_factor(i));
+  return *race_time_with_pits_under(m.stints(), m.pits(), f);
+}
+
+TEST_CASE("StrategyModel total matches race_time_with_pits_under") {
+  auto m = StrategyModel::create({{3, 90.0, 0.2}, {2, 91.0, 0.1}}, {{2.5, 17.0}}, {0.5});
+  REQUIRE(m.has_value());
+  REQUIRE(m->total() == Approx(270.6 + 11.0 + 182.1));
+  REQUIRE(m->total_laps() == 5);
+  REQUIRE(m->time_at_stop(0) == Approx(270.6));
+}
+
+TEST_CASE("StrategyModel edits report deltas and stay consistent") {
+  auto m = StrategyModel::create({{18, 90.0, 0.2}, {20, 90.6, 0.09}, {19, 91.1, 0.05}},
+                                 {{2.4, 19.0}, {2.4, 19.0}});
+  REQUIRE(m.has_value());
+  REQUIRE(m->total() == Approx(rescore(*m)));
+
+  SECTION("move a stop") {
+    const double before = m->total();
+    const auto preview = m->move_stop_delta(0, 3);
+    const auto d = m->move_stop(0, 3);
+    REQUIRE(d.has_value());
+    REQUIRE(*d == Approx(*preview));
+    REQUIRE(m->stint(0).laps == 21);
+    REQUIRE(m->stint(1).laps == 17);
+    REQUIRE(m->total_laps() == 57);
+    REQUIRE(m->total() - before == Approx(*d));
+    REQUIRE(m->total() == Approx(rescore(*m)));
+    REQUIRE_FALSE(m->move_stop(1, -40).has_value());
+    REQUIRE_FALSE(m->move_stop(2, 1).has_value());
+  }
+  SECTION("swap compound and change stop parameters") {
+    const double before = m->total();
+    const auto d1 = m->set_stint(2, {19, 90.6, 0.09});
+    const auto d2 = m->set_lane_factor(1, 0.45);
+    const auto d3 = m->set_stop(0, {3.0, 19.0});
+    REQUIRE(d1.has_value());
+    REQUIRE(d2.has_value());
+    REQUIRE(d3.has_value());
+    REQUIRE(*d2 == Approx(-19.0 * 0.55));
+    REQUIRE(*d3 == Approx(0.6));
+    REQUIRE(m->total() - before == Approx(*d1 + *d2 + *d3));
+    REQUIRE(m->total() == Approx(rescore(*m)));
+    REQUIRE_FALSE(m->set_stop(2, {}).has_value());
+    REQUIRE_FALSE(m->set_stint(3, {}).has_value());
+  }
+}
+
+TEST_CASE("StrategyModel stays exact over many random edits") {
+  std::vector<StintParams> st;
+  for (int i = 0; i < 9; ++i) st.push_back({8, 90.0 + 0.1 * i, 0.05 + 0.01 * i});
+  auto m = StrategyModel::create(st, std::vector<PitParams>(8, {2.4, 19.0}));
+  REQUIRE(m.has_value());
+  std::mt19937 rng(3);
+  std::uniform_int_distribution<int> stop(0, 7), shift(-3, 3);
+  std::uniform_real_distribution<double> f(0.3, 1.0);
+  for (int k = 0; k < 2000; ++k) {
+    if (k % 3 == 0) m->set_lane_factor(std::size_t(stop(rng)), f(rng));
+    else m->move_stop(std::size_t(stop(rng)), shift(rng));
+  }
+  REQUIRE(m->total_laps() == 72);
+  REQUIRE(m->total() == Approx(rescore(*m)).epsilon(1e-12));
+}
+
+TEST_CASE("StrategyModel::create validates sizes") {
+  REQUIRE_FALSE(StrategyModel::create({}, {}).has_value());
+  REQUIRE_FALSE(StrategyModel::create({{1, 90, 0}}, {{2, 10}}).has_value());
+  REQUIRE_FALSE(StrategyModel::create({{1, 90, 0}, {1, 90, 0}}, {{2, 10}}, {0.5, 0.5}).has_value());
+}
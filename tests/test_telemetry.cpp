@@ -0,0 +1,165 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <algorithm>
+#include <numeric>
+
+#include <f1tm/sim.hpp>
+#include <f1tm/telemetry.hpp>
+
+using Catch::Approx;
+using namespace f1tm;
+
+// Runs the sim at a fixed dt, updating telemetry each tick, for `seconds`.
+static void run_for(SimServer& sim, TelemetrySink& telem, double& t, double dt, double seconds) {
+  const int steps = int(seconds / dt + 0.5);
+  for (int i = 0; i < steps; ++i) {
+    sim.step(dt);
+    t += dt;
+    telem.update(sim, t);
+  }
+}
+
+TEST_CASE("TelemetrySink builds a sorted timing-line table") {
+  SECTION("default: three sectors") {
+    TelemetrySink telem;
+    REQUIRE(telem.mini_sector_count() == 3);
+    REQUIRE(telem.line_count() == 3);
+    REQUIRE(telem.line_fractions().back() == Approx(1.0));
+  }
+  SECTION("mini-sectors merge with the sector lines") {
+    TelemetrySink telem(25);                  // 1/3 and 2/3 are not multiples of 1/25
+    REQUIRE(telem.mini_sector_count() == 25);
+    REQUIRE(telem.line_count() == 27);
+    const auto& f = telem.line_fractions();
+    REQUIRE(std::is_sorted(f.begin(), f.end()));
+    TelemetrySink six(6);                     // 2/6 and 4/6 coincide with sector lines
+    REQUIRE(six.mini_sector_count() == 6);
+    REQUIRE(six.line_count() == 6);
+  }
+}
+
+TEST_CASE("TelemetrySink times laps, sectors and mini-sectors") {
+  SimServer sim;
+  sim.track.radius_m = 50.0;
+  const double C = sim.track.circumference_m();
+  const double v = 50.0;
+  sim.add_car(4, v, 0.0);
+  sim.add_car(9, v * 0.5, 0.0);
+
+  TelemetrySink telem(25);
+  const double dt = 1.0 / 240.0;
+  double t = 0.0;
+  telem.update(sim, t);
+
+  TelemetryTimes tt{};
+  SECTION("first lap-line crossing only starts timing") {
+    run_for(sim, telem, t, dt, C / v + 0.1);
+    REQUIRE(telem.get(4, tt));
+    REQUIRE(tt.laps == 1);
+    REQUIRE(tt.last_lap < 0.0);
+    REQUIRE(tt.s_last[0] < 0.0);
+  }
+  SECTION("full laps produce lap, sector and mini-sector times") {
+    run_for(sim, telem, t, dt, 3.0 * C / v + 0.1);
+    REQUIRE(telem.get(4, tt));
+    REQUIRE(tt.laps == 3);
+    REQUIRE(tt.last_lap == Approx(C / v).margin(2.0 * dt));
+    REQUIRE(tt.best_lap <= tt.last_lap);
+    for (int k = 0; k < 3; ++k) REQUIRE(tt.s_last[k] == Approx(C / v / 3.0).margin(2.0 * dt));
+
+    // One time per requested mini-sector; sector lines do not split them
+    REQUIRE(tt.mini_last.size() == 25);
+    REQUIRE(tt.mini_best.size() == 25);
+    for (double m : tt.mini_last) REQUIRE(m == Approx(C / v / 25.0).margin(2.0 * dt));
+    const double sum = std::accumulate(tt.mini_last.begin(), tt.mini_last.end(), 0.0);
+    REQUIRE(sum == Approx(tt.last_lap).margin(1e-9));
+
+    // Slot lookup by index matches lookup by id
+    TelemetryTimes by_idx{};
+    REQUIRE(telem.get_index(0, by_idx));
+    REQUIRE(by_idx.last_lap == tt.last_lap);
+
+    // Slower car has completed its first lap line only
+    REQUIRE(telem.get(9, tt));
+    REQUIRE(tt.laps == 1);
+    REQUIRE(tt.last_lap < 0.0);
+  }
+  SECTION("unknown ids are reported") {
+    REQUIRE_FALSE(telem.get(77, tt));
+    REQUIRE_FALSE(telem.get_index(5, tt));
+  }
+}
+
+TEST_CASE("TelemetrySink handles several lines crossed in one tick") {
+  SimServer sim;
+  sim.track.radius_m = 10.0;
+  const double C = sim.track.circumference_m();
+  sim.add_car(0, C, 0.0);                     // one lap per second
+
+  TelemetrySink telem(25);
+  double t = 0.0;
+  telem.update(sim, t);
+  run_for(sim, telem, t, 0.25, 3.0);          // ~7 mini-sectors per tick
+
+  TelemetryTimes tt{};
+  REQUIRE(telem.get(0, tt));
+  REQUIRE(tt.laps == 3);
+  REQUIRE(tt.last_lap == Approx(1.0).margin(1e-9));
+}
+
+TEST_CASE("TelemetrySink interpolates crossing times within a tick") {
+  SimServer sim;
+  sim.track.radius_m = 50.0;
+  const double C = sim.track.circumference_m();
+  const double v = 47.0;                       // lap time not a multiple of dt
+  sim.add_car(0, v, 0.0);
+
+  SECTION("coarse and fine tick rates agree to numerical precision") {
+    for (double dt : {1.0 / 240.0, 1.0 / 30.0, 4.0 / 60.0}) {
+      SimServer s2 = sim;
+      TelemetrySink telem;
+      double t = 0.0;
+      telem.update(s2, t);
+      run_for(s2, telem, t, dt, 3.2 * C / v);
+      TelemetryTimes tt{};
+      REQUIRE(telem.get(0, tt));
+      REQUIRE(tt.last_lap == Approx(C / v).margin(1e-9));
+      for (int k = 0; k < 3; ++k) REQUIRE(tt.s_last[k] == Approx(C / v / 3.0).margin(1e-9));
+      REQUIRE(tt.lap_line_time == Approx(3.0 * C / v).margin(1e-9)); // not the tick's end
+    }
+  }
+}
+
+TEST_CASE("TelemetrySink aggregates laps into a RaceSummary") {
+  SimServer sim;
+  sim.track.radius_m = 50.0;
+  const double C = sim.track.circumference_m();
+  sim.add_car(1, 40.0, 0.0);
+  sim.add_car(2, 50.0, 0.0);
+
+  TelemetrySink telem;
+  const double dt = 1.0 / 120.0;
+  double t = 0.0;
+  telem.update(sim, t);
+  run_for(sim, telem, t, dt, 6.5 * C / 50.0);
+
+  const auto* ls = telem.lap_stats(1);
+  REQUIRE(ls != nullptr);
+  REQUIRE(ls->count() == 5);                   // first crossing only starts timing
+  REQUIRE(ls->moments.mean() == Approx(C / 50.0).margin(1e-9));
+  REQUIRE(ls->moments.stddev() == Approx(0.0).margin(1e-9));
+  REQUIRE(telem.sector_stats(1, 2)->count() == 5);
+  REQUIRE(telem.sector_stats(1, 3) == nullptr);
+
+  const RaceSummary summary = telem.summary(t);
+  REQUIRE(summary.finish_time() == Approx(t));
+  REQUIRE(summary.cars().size() == 2);
+  REQUIRE(summary.cars().front().id == 2);     // leader first
+  const auto* c2 = summary.find(2);
+  REQUIRE(c2 != nullptr);
+  REQUIRE(c2->laps == 6);
+  REQUIRE(c2->total_time == Approx(5.0 * C / 50.0));
+  REQUIRE(c2->lap.p50 == Approx(C / 50.0));
+  REQUIRE(c2->sector[0].mean == Approx(C / 150.0));
+  REQUIRE(summary.find(99) == nullptr);
+}
@@ -0,0 +1,113 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <algorithm>
+#include <cstdint>
+
+#include <f1tm/tick_scheduler.hpp>
+
+using Catch::Approx;
+using namespace f1tm;
+
+namespace {
+
+constexpr std::int64_t kPeriod = 1000; // made-up ns
+
+// One tick that starts at `start`, works `work` ns and sleeps exactly to the deadline.
+struct Tick {
+  std::uint32_t periods;
+  std::int64_t wake;
+};
+Tick run_tick(TickScheduler& s, std::int64_t start, std::int64_t work, std::int64_t overshoot = 0) {
+  const auto periods = s.begin_tick(start);
+  const auto wake = s.end_tick(start + work);
+  s.woke(std::max(wake, start + work) + overshoot);
+  return {periods, wake};
+}
+
+} // namespace
+
+TEST_CASE("TickScheduler keeps a fixed cadence when ticks fit the budget") {
+  TickStats st;
+  TickScheduler s(st, kPeriod);
+  s.start(0);
+  std::int64_t t = 0;
+  for (int i = 0; i < 10; ++i) {
+    const auto tk = run_tick(s, t, 300, 20);
+    REQUIRE(tk.periods == 1);
+    REQUIRE(tk.wake == (i + 1) * kPeriod);
+    t = tk.wake + 20;
+  }
+  REQUIRE(st.ticks == 10);
+  REQUIRE(st.overruns == 0);
+  REQUIRE(st.late_ticks == 0);
+  REQUIRE(st.work_ns_last == 300);
+  REQUIRE(st.work_ns_max == 300);
+  REQUIRE(st.work_ns_total == 3000);
+  REQUIRE(st.overshoot_ns_max == 20);
+}
+
+TEST_CASE("TickScheduler Burst runs missed ticks back to back") {
+  TickStats st;
+  TickScheduler s(st, kPeriod, CatchUpPolicy::Burst);
+  s.start(0);
+  // One 3.5-period stall, then fast ticks.
+  auto tk = run_tick(s, 0, 3500);
+  REQUIRE(tk.wake == 1000);
+  REQUIRE(st.overruns == 1);
+  std::int64_t t = 3500;
+  int immediate = 0;
+  while (tk.wake < t) {  // deadline already past: no sleep
+    tk = run_tick(s, t, 100);
+    REQUIRE(tk.periods == 1);
+    t += 100;
+    ++immediate;
+  }
+  REQUIRE(immediate == 3);
+  REQUIRE(st.late_ticks == 2);     // ticks starting a whole period behind
+  REQUIRE(st.bursts == 1);
+  REQUIRE(tk.wake == 4000);        // back on the original grid
+  REQUIRE(st.overshoot_ns_max == 0);
+}
+
+TEST_CASE("TickScheduler Drop folds missed periods into one step") {
+  TickStats st;
+  TickScheduler s(st, kPeriod, CatchUpPolicy::Drop);
+  s.start(0);
+  run_tick(s, 0, 3500);
+  const auto tk = run_tick(s, 3500, 100);
+  REQUIRE(tk.periods == 3);        // its own period plus the two missed ones
+  REQUIRE(st.dropped_ticks == 2);
+  REQUIRE(tk.wake == 4000);        // next tick waits for the grid again
+  REQUIRE(run_tick(s, 4000, 100).periods == 1);
+
+  // Long stalls fold at most kMaxFoldedPeriods into a step.
+  run_tick(s, 5000, 50000);
+  REQUIRE(run_tick(s, 55000, 100).periods == TickScheduler::kMaxFoldedPeriods);
+}
+
+TEST_CASE("TickScheduler SlowDown re-anchors the schedule instead of catching up") {
+  TickStats st;
+  TickScheduler s(st, kPeriod, CatchUpPolicy::SlowDown);
+  s.start(0);
+  run_tick(s, 0, 3500);
+  const auto tk = run_tick(s, 3500, 100);
+  REQUIRE(tk.periods == 1);
+  REQUIRE(tk.wake == 4500);        // one period after the late start
+  REQUIRE(st.resyncs == 1);
+  REQUIRE(st.dropped_ticks == 0);
+}
+
+TEST_CASE("TickScheduler reports the achieved tick rate and resets") {
+  TickStats st;
+  TickScheduler s(st, 1'000'000); // 1 ms
+  s.start(0);
+  std::int64_t t = 0;
+  for (int i = 0; i <= 1000; ++i) {
+    const auto tk = run_tick(s, t, 10'000);
+    t = tk.wake;
+  }
+  REQUIRE(st.tick_hz.load() == Approx(1000.0).epsilon(0.01));
+  st.reset();
+  REQUIRE(st.ticks == 0);
+  REQUIRE(st.tick_hz.load() == 0.0);
+}
@@ -0,0 +1,45 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+
+#include <f1tm/track_catalog.hpp>
+
+using namespace f1tm;
+
+TEST_CASE("TrackCatalog finds tracks by key without copies") {
+  std::vector<Track> tracks;
+  for (int i = 0; i < 500; ++i) {
+    tracks.push_back({"Track" + std::to_string(i), 2.0 + i * 0.001, 18.0, 0.5, 0.8});
+  }
+  tracks.push_back({"Track7", 9.9, 9.9, 0.1, 0.1}); // duplicate: first wins
+  const TrackCatalog cat(tracks);
+  REQUIRE(cat.size() == 501);
+  REQUIRE_FALSE(cat.fold_case());
+
+  for (int i = 0; i < 500; ++i) {
+    const std::string key = "Track" + std::to_string(i);
+    const auto id = cat.id(key);
+    REQUIRE(id);
+    REQUIRE(*id == TrackId(i));
+    REQUIRE(cat.find(key) == &cat[*id]);
+  }
+  REQUIRE(cat.find("Track7")->pit_stationary_s == 2.007);
+  REQUIRE_FALSE(cat.id("track7"));
+  REQUIRE_FALSE(cat.id("Track500"));
+  REQUIRE(cat.find("") == nullptr);
+  REQUIRE(TrackCatalog{}.find("Bahrain") == nullptr);
+}
+
+TEST_CASE("TrackCatalog case folding and stable references") {
+  TrackCatalog cat({{"Bahrain", 2.5, 17.0, 0.45, 0.75}, {"Monaco", 2.5, 21.0, 0.40, 0.70}}, true);
+  REQUIRE(cat.id("bahrain") == TrackId(0));
+  REQUIRE(cat.id("MONACO") == TrackId(1));
+  REQUIRE_FALSE(cat.id("Monac"));
+
+  const Track* mon = cat.find("monaco");
+  const TrackCatalog moved = std::move(cat);
+  REQUIRE(moved.find("Monaco") == mon);
+
+  REQUIRE(builtin_track_catalog().find("bahrain") != nullptr);
+  REQUIRE(builtin_track_catalog().find("bahrain")->pit_lane_delta_s == track_by_key("Bahrain")->pit_lane_delta_s);
+}
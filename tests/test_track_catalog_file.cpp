@@ -0,0 +1,146 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <f1tm/track_catalog_file.hpp>
+
+using namespace f1tm;
+
+namespace {
+const std::string kCsv = "key,stat,lane,sc,vsc\nBahrain,2.6,16.5,0.50,0.80\nMonaco,2.5,21.5,0.40,0.70\n";
+
+void write_text(const std::string& path, const std::string& text) {
+  std::ofstream f(path, std::ios::binary | std::ios::trunc);
+  f << text;
+}
+} // namespace
+
+TEST_CASE("Compiled track catalog round-trips tracks and lookups") {
+  const auto path = (std::filesystem::temp_directory_path() / "f1tm_test_roundtrip.f1cat").string();
+  std::vector<Track> tracks;
+  for (int i = 0; i < 300; ++i) {
+    tracks.push_back({"Circuit" + std::to_string(i), 2.0 + i, 18.0 + i, 0.5, 0.75});
+  }
+  tracks.push_back({"circuit3", 0.0, 0.0, 0.0, 0.0}); // folded duplicate: first wins
+  REQUIRE(write_compiled_track_catalog(path, tracks, CatSourceStamp{1, 2, 3}, true));
+
+  CompiledTrackCatalog cat;
+  REQUIRE(cat.open(path));
+  REQUIRE(cat.size() == tracks.size());
+  REQUIRE(cat.fold_case());
+  REQUIRE(cat.header().source.mtime == 2);
+  for (TrackId i = 0; i < 300; ++i) {
+    REQUIRE(cat.key(i) == tracks[i].key);
+    REQUIRE(cat.id(tracks[i].key) == i);
+  }
+  REQUIRE(cat.id("CIRCUIT42") == TrackId(42));
+  REQUIRE(cat.find("circuit3")->pit_stationary_s == 5.0);
+  REQUIRE_FALSE(cat.id("Circuit300"));
+  const auto all = cat.tracks();
+  REQUIRE(all.back().key == "circuit3");
+  REQUIRE(all[7].pit_lane_delta_s == 25.0);
+
+  // Truncated or foreign files are rejected
+  const auto size = std::filesystem::file_size(path);
+  std::filesystem::resize_file(path, size - 1);
+  REQUIRE_FALSE(cat.open(path));
+  REQUIRE_FALSE(cat.id("Circuit1"));
+  write_text(path, kCsv);
+  REQUIRE_FALSE(cat.open(path));
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("open_track_catalog_cached rebuilds only when the source changes") {
+  const auto dir = std::filesystem::temp_directory_path();
+  const auto csv = (dir / "f1tm_test_cached.csv").string();
+  const auto bin = (dir / "f1tm_test_cached.f1cat").string();
+  std::filesystem::remove(bin);
+  write_text(csv, kCsv);
+
+  CompiledTrackCatalog cat;
+  REQUIRE(open_track_catalog_cached(csv, bin, cat) == CatalogCacheResult::Rebuilt);
+  REQUIRE(cat.size() == 2);
+  REQUIRE(cat.find("monaco")->pit_lane_delta_s == 21.5);
+  REQUIRE(open_track_catalog_cached(csv, bin, cat) == CatalogCacheResult::Hit);
+
+  // Touched, same bytes: no parse, new stamp
+  const auto t0 = std::filesystem::last_write_time(csv);
+  std::filesystem::last_write_time(csv, t0 + std::chrono::seconds(5));
+  REQUIRE(open_track_catalog_cached(csv, bin, cat) == CatalogCacheResult::Restamped);
+  REQUIRE(open_track_catalog_cached(csv, bin, cat) == CatalogCacheResult::Hit);
+
+  // New content
+  write_text(csv, kCsv + "Spa,2.4,18.0,0.5,0.8\n");
+  std::filesystem::last_write_time(csv, t0 + std::chrono::seconds(10));
+  REQUIRE(open_track_catalog_cached(csv, bin, cat) == CatalogCacheResult::Rebuilt);
+  REQUIRE(cat.size() == 3);
+
+  // Index folding is part of the stamp
+  REQUIRE(open_track_catalog_cached(csv, bin, cat, false) == CatalogCacheResult::Rebuilt);
+  REQUIRE_FALSE(cat.id("spa"));
+  REQUIRE(cat.id("Spa") == TrackId(2));
+
+  // Missing source
+  REQUIRE_FALSE(open_track_catalog_cached((dir / "f1tm_missing.csv").string(), bin, cat));
+  std::filesystem::remove(csv);
+  std::filesystem::remove(bin);
+}
+
+TEST_CASE("Concurrent rebuilds of one compiled catalog never mix their files") {
+  const auto dir = std::filesystem::temp_directory_path() / "f1tm_test_concurrent_cat";
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  const auto path = (dir / "tracks.f1cat").string();
+
+  // Writers with different catalogs; every record of writer w has lane delta w.
+  constexpr int kWriters = 4;
+  std::vector<std::vector<Track>> cats(kWriters);
+  for (int w = 0; w < kWriters; ++w) {
+    for (int i = 0; i < 20000 + 5000 * w; ++i) {
+      cats[w].push_back({"Circuit" + std::to_string(i), 2.0, double(w), 0.5, 0.75});
+    }
+  }
+  // A catalog is good if it is exactly one writer's.
+  auto whole = [&](const CompiledTrackCatalog& cat) {
+    const auto w = cat.header().source.hash;
+    if (w >= std::uint64_t(kWriters) || cat.size() != cats[w].size()) return false;
+    for (const auto& t : cat.tracks()) if (t.pit_lane_delta_s != double(w)) return false;
+    return true;
+  };
+
+  std::atomic<int> running{kWriters};
+  std::vector<int> failed(kWriters, 0);
+  std::vector<std::thread> writers;
+  for (int w = 0; w < kWriters; ++w) {
+    writers.emplace_back([&, w] {
+      for (int i = 0; i < 20; ++i) {
+        if (!write_compiled_track_catalog(path, cats[w], CatSourceStamp{1, 2, std::uint64_t(w)})) ++failed[w];
+      }
+      --running;
+    });
+  }
+  int opened = 0, bad = 0;
+  while (running.load() > 0) {
+    CompiledTrackCatalog cat;
+    if (!cat.open(path)) continue;  // not created yet
+    ++opened;
+    if (!whole(cat)) ++bad;
+  }
+  for (auto& t : writers) t.join();
+  for (int f : failed) REQUIRE(f == 0);
+  REQUIRE(bad == 0);
+  INFO("reader opened " << opened << " catalogs while writing");
+
+  // The survivor is complete, and no temporary files remain.
+  CompiledTrackCatalog cat;
+  REQUIRE(cat.open(path));
+  REQUIRE(whole(cat));
+  cat.close();
+  REQUIRE(std::distance(std::filesystem::directory_iterator(dir), std::filesystem::directory_iterator{}) == 1);
+  std::filesystem::remove_all(dir);
+}
@@ -1,5 +1,7 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_approx.hpp>
+#include <filesystem>
+#include <fstream>
 #include <sstream>
 #include <optional>
 #include <vector>
@@ -51,3 +53,54 @@ TEST_CASE("load_track_catalog_csv returns nullopt on missing file") {
   auto none = load_track_catalog_csv("this_file_does_not_exist.csv");
   REQUIRE_FALSE(none.has_value());
 }
+
+TEST_CASE("track_catalog_from_csv keeps the stream loader's row rules") {
+  const std::string text =
+    "Key,a,b,c,d\r\n"                 // header (CRLF)
+    "key,1,2,3,4\n"                   // only the first header is skipped; this one is data
+    "\t# indented comment\n"
+    "Spa,+2.4,18.0,0.5,0.8,extra\n"   // leading '+', extra columns ignored
+    "Imola,2.4,x,0.5,0.8\n"           // non-numeric field
+    "Suzuka,2.4,18.0,0.5\n"           // too few columns
+    "Monza,2.4,18.0 5,0.5,0.8\n"      // trailing garbage in a field
+    "Jeddah,-1,19.0,1.5,-0.2";        // clamped; no trailing newline
+  const auto cat = track_catalog_from_csv(text);
+  REQUIRE(cat.size() == 3);
+  REQUIRE(cat[0].key == "key");
+  REQUIRE(cat[1].key == "Spa");
+  REQUIRE(cat[1].pit_stationary_s == Approx(2.4));
+  REQUIRE(cat[2].key == "Jeddah");
+  REQUIRE(cat[2].pit_stationary_s == 0.0);
+  REQUIRE(cat[2].sc_lane_factor == 1.0);
+  REQUIRE(cat[2].vsc_lane_factor == 0.0);
+
+  std::istringstream ss(text);
+  const auto via_stream = track_catalog_from_csv_stream(ss);
+  REQUIRE(via_stream.size() == cat.size());
+  for (std::size_t i = 0; i < cat.size(); ++i) {
+    REQUIRE(via_stream[i].key == cat[i].key);
+    REQUIRE(via_stream[i].pit_lane_delta_s == cat[i].pit_lane_delta_s);
+  }
+  REQUIRE(track_catalog_from_csv("").empty());
+  REQUIRE(track_catalog_from_csv(csv_with_noise).size() == 2);
+}
+
+TEST_CASE("load_track_catalog_csv maps files and accepts empty ones") {
+  const auto dir = std::filesystem::temp_directory_path();
+  const auto full = (dir / "f1tm_test_tracks.csv").string();
+  const auto empty = (dir / "f1tm_test_tracks_empty.csv").string();
+  { std::ofstream(full) << csv_minimal; }
+  { std::ofstream e(empty); }
+
+  const auto cat = load_track_catalog_csv(full);
+  REQUIRE(cat.has_value());
+  REQUIRE(cat->size() == 2);
+  REQUIRE(track_by_key_in(*cat, "Monaco")->pit_lane_delta_s == Approx(21.5));
+
+  const auto none = load_track_catalog_csv(empty);
+  REQUIRE(none.has_value());
+  REQUIRE(none->empty());
+
+  std::filesystem::remove(full);
+  std::filesystem::remove(empty);
+}
@@ -0,0 +1,76 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <cmath>
+#include <vector>
+
+#include <f1tm/track_geom.hpp>
+
+using Catch::Approx;
+using namespace f1tm;
+
+// Axis-aligned 100 x 50 rectangle, counter-clockwise from the origin.
+static TrackPath make_rect() {
+  return TrackPath{{ {0.0, 0.0}, {100.0, 0.0}, {100.0, 50.0}, {0.0, 50.0} }};
+}
+
+TEST_CASE("TrackPath precomputes unit left normals per segment") {
+  const auto p = make_rect();
+  REQUIRE(p.length() == Approx(300.0));
+  const auto& n = p.segment_normals();
+  REQUIRE(n.size() == 4);
+  REQUIRE(n[0].x == Approx(0.0).margin(1e-12));  // +x segment -> left is +y
+  REQUIRE(n[0].y == Approx(1.0));
+  REQUIRE(n[1].x == Approx(-1.0));               // +y segment -> left is -x
+  REQUIRE(n[1].y == Approx(0.0).margin(1e-12));
+}
+
+TEST_CASE("TrackPath sample_pose applies lateral offset along the normal") {
+  const auto p = make_rect();
+  double x, y, h;
+
+  SECTION("zero lateral matches the centerline overload") {
+    double x0, y0, h0;
+    p.sample_pose(130.0, x0, y0, h0);
+    p.sample_pose(130.0, 0.0, x, y, h);
+    REQUIRE(x == Approx(x0));
+    REQUIRE(y == Approx(y0));
+    REQUIRE(h == Approx(h0));
+  }
+  SECTION("positive lateral is left of travel, negative is right") {
+    p.sample_pose(40.0, 3.0, x, y, h);
+    REQUIRE(x == Approx(40.0));
+    REQUIRE(y == Approx(3.0));
+    REQUIRE(h == Approx(0.0).margin(1e-12));
+    p.sample_pose(40.0, -3.0, x, y, h);
+    REQUIRE(y == Approx(-3.0));
+  }
+  SECTION("negative s wraps to the end of the lap") {
+    p.sample_pose(-10.0, 2.0, x, y, h);
+    REQUIRE(x == Approx(0.0 + 2.0));               // last segment runs -y, left is +x
+    REQUIRE(y == Approx(10.0));
+    REQUIRE(std::sin(h) == Approx(-1.0));
+  }
+}
+
+TEST_CASE("TrackPath sample_poses batch matches scalar sampling") {
+  const auto p = TrackPath::Stadium(250.0, 80.0, 14);
+  const std::vector<double> s{ 0.0, 55.5, 310.0, 777.7, -20.0 };
+  const std::vector<double> lat{ -3.0, 3.0, 0.0, 1.5, -1.5 };
+  std::vector<double> x(s.size()), y(s.size()), h(s.size());
+  p.sample_poses(s.data(), lat.data(), s.size(), x.data(), y.data(), h.data());
+
+  for (std::size_t i = 0; i < s.size(); ++i) {
+    double xi, yi, hi;
+    p.sample_pose(s[i], lat[i], xi, yi, hi);
+    REQUIRE(x[i] == Approx(xi));
+    REQUIRE(y[i] == Approx(yi));
+    REQUIRE(h[i] == Approx(hi));
+  }
+
+  // nullptr lateral samples the centerline
+  p.sample_poses(s.data(), nullptr, s.size(), x.data(), y.data(), h.data());
+  double xc, yc, hc;
+  p.sample_pose(s[1], xc, yc, hc);
+  REQUIRE(x[1] == Approx(xc));
+  REQUIRE(y[1] == Approx(yc));
+}
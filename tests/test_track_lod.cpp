@@ -0,0 +1,75 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <vector>
+
+#include <f1tm/track_lod.hpp>
+
+using namespace f1tm;
+
+static Box2 box(float x0, float y0, float x1, float y1) { return Box2{x0, y0, x1, y1}; }
+
+TEST_CASE("BoxTree returns overlapping leaves as ordered runs") {
+  // Ten unit boxes along x: leaf i covers [i, i+1].
+  std::vector<Box2> leaves;
+  for (int i = 0; i < 10; ++i) leaves.push_back(box(float(i), 0.0f, float(i + 1), 1.0f));
+  BoxTree t;
+  t.build(leaves);
+  REQUIRE(t.leaf_count() == 10);
+
+  std::vector<BoxTree::Run> runs;
+  t.query(box(2.5f, 0.2f, 5.5f, 0.8f), runs);
+  REQUIRE(runs == std::vector<BoxTree::Run>{{2, 6}});
+
+  t.query(box(-5.0f, -5.0f, 20.0f, 5.0f), runs);
+  REQUIRE(runs == std::vector<BoxTree::Run>{{0, 10}});
+
+  t.query(box(0.0f, 2.0f, 10.0f, 3.0f), runs);
+  REQUIRE(runs.empty());
+}
+
+TEST_CASE("BoxTree splits runs around empty leaves") {
+  std::vector<Box2> leaves{box(0, 0, 1, 1), Box2{}, box(2, 0, 3, 1)};
+  BoxTree t;
+  t.build(leaves);
+  std::vector<BoxTree::Run> runs;
+  t.query(box(0, 0, 3, 1), runs);
+  REQUIRE(runs == std::vector<BoxTree::Run>{{0, 1}, {2, 3}});
+}
+
+TEST_CASE("decimate_closed_path drops collinear points within tolerance") {
+  // Square with 10 points per side, slightly noisy.
+  std::vector<Vec2> pts;
+  for (int i = 0; i < 10; ++i) pts.push_back({i * 10.0, (i % 2) * 0.01});
+  for (int i = 0; i < 10; ++i) pts.push_back({100.0, i * 10.0});
+  for (int i = 0; i < 10; ++i) pts.push_back({100.0 - i * 10.0, 100.0});
+  for (int i = 0; i < 10; ++i) pts.push_back({0.0, 100.0 - i * 10.0});
+  pts.push_back(pts.front());
+
+  const auto d = decimate_closed_path(pts, 0.1);
+  REQUIRE(d.size() == 5); // four corners, closed
+  REQUIRE(d.front().x == d.back().x);
+  REQUIRE(d.front().y == d.back().y);
+
+  const auto fine = decimate_closed_path(pts, 0.001);
+  REQUIRE(fine.size() > d.size());
+}
+
+TEST_CASE("TrackLod picks coarser outlines as the zoom drops") {
+  TrackLod lod;
+  REQUIRE(lod.level_count() == 1);
+
+  const auto path = TrackPath::Stadium(600.0, 120.0, 48);
+  lod.build(path);
+  REQUIRE(lod.level_count() > 2);
+  REQUIRE(lod.level(0).size() == path.points().size());
+  for (std::size_t k = 1; k < lod.level_count(); ++k) {
+    REQUIRE(lod.level(k).size() < lod.level(k - 1).size());
+    REQUIRE(lod.tolerance_m(k) > lod.tolerance_m(k - 1));
+  }
+
+  const auto near = lod.level_for(20.0f);
+  const auto far = lod.level_for(0.05f);
+  REQUIRE(near < far);
+  REQUIRE(lod.tolerance_m(far) * 0.05 <= 0.5);
+  REQUIRE(lod.points_for(0.05f).size() < path.points().size());
+}
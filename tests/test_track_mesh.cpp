@@ -0,0 +1,145 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <f1tm/track_mesh.hpp>
+
+using Catch::Approx;
+using namespace f1tm;
+
+// Axis-aligned 100 x 50 rectangle, counter-clockwise from the origin.
+static TrackPath make_rect() {
+  return TrackPath{{ {0.0, 0.0}, {100.0, 0.0}, {100.0, 50.0}, {0.0, 50.0} }};
+}
+
+static bool same(MeshColor a, MeshColor b) {
+  return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+static std::size_t count_color(const TrackMesh& m, MeshColor c) {
+  std::size_t n = 0;
+  const auto& v = m.vertices();
+  for (std::size_t i = 0; i < v.size(); i += 3) n += same(v[i].c, c) ? 1 : 0;
+  return n;
+}
+
+TEST_CASE("TrackMesh emits whole counter-clockwise screen triangles") {
+  TrackMesh m;
+  m.build(TrackPath::Stadium(400.0, 80.0), TrackMeshParams{3.0f, 12.0f, 8});
+  const auto& v = m.vertices();
+  REQUIRE_FALSE(v.empty());
+  REQUIRE(v.size() % 3 == 0);
+  for (std::size_t i = 0; i < v.size(); i += 3) {
+    const float cross = (v[i+1].x - v[i].x) * (v[i+2].y - v[i].y) -
+                        (v[i+1].y - v[i].y) * (v[i+2].x - v[i].x);
+    REQUIRE(cross <= 0.0f); // y-down screen space
+  }
+}
+
+TEST_CASE("TrackMesh asphalt is a mitred strip at half width in pixels") {
+  const auto path = make_rect();
+  const TrackMeshParams p{2.0f, 12.0f, 0};
+  TrackMesh m;
+  m.build(path, p);
+  const MeshColor asphalt{40, 40, 46, 255};
+  REQUIRE(count_color(m, asphalt) == 2 * (path.points().size() - 1));
+
+  // Corner (100, 0) -> pixels (200, 0); the mitre is (+-6, +-6) * 2 px/m at 45 degrees.
+  bool found_outer = false, found_inner = false;
+  for (const auto& v : m.vertices()) {
+    if (!same(v.c, asphalt)) continue;
+    found_outer |= v.x == Approx(212.0f) && v.y == Approx(12.0f);
+    found_inner |= v.x == Approx(188.0f) && v.y == Approx(-12.0f);
+  }
+  REQUIRE(found_outer);
+  REQUIRE(found_inner);
+}
+
+TEST_CASE("TrackMesh positions are origin-relative and scale with zoom") {
+  const auto path = make_rect();
+  TrackMesh a, b;
+  a.build(path, TrackMeshParams{1.0f, 12.0f, 0});
+  b.build(path, TrackMeshParams{2.0f, 12.0f, 0});
+  // First asphalt vertex is the mitred outer corner at the origin, in y-down pixels.
+  REQUIRE(a.vertices()[0].x == Approx(-6.0f));
+  REQUIRE(a.vertices()[0].y == Approx(6.0f));
+  REQUIRE(b.vertices()[0].x == Approx(-12.0f));
+  REQUIRE(b.vertices()[0].y == Approx(12.0f));
+  REQUIRE(b.params().scale_px_per_m == 2.0f);
+}
+
+TEST_CASE("TrackMesh kerbs alternate red and white dashes") {
+  TrackMesh m;
+  m.build(make_rect(), TrackMeshParams{2.0f, 12.0f, 0});
+  const MeshColor red{200, 70, 70, 255}, white{235, 235, 235, 255};
+  std::size_t reds = 0, whites = 0;
+  const MeshColor* prev = nullptr;
+  const auto& v = m.vertices();
+  for (std::size_t i = 0; i < v.size(); i += 6) { // one dash = two triangles
+    const bool r = same(v[i].c, red), w = same(v[i].c, white);
+    if (!r && !w) continue;
+    if (prev) REQUIRE(same(*prev, r ? white : red));
+    prev = &v[i].c;
+    (r ? reds : whites) += 1;
+  }
+  // 600 px of centreline in 14 px dashes (one 12 px remainder per 100 px side).
+  REQUIRE(reds + whites > 40);
+  REQUIRE((reds > whites ? reds - whites : whites - reds) <= 1);
+}
+
+TEST_CASE("TrackMesh draws one grid box per car and checker squares") {
+  TrackMesh m;
+  m.build(make_rect(), TrackMeshParams{2.0f, 12.0f, 5});
+  REQUIRE(count_color(m, MeshColor{255, 255, 255, 30}) == 2 * 5);
+  REQUIRE(count_color(m, MeshColor{240, 240, 240, 255}) == 2 * 5);
+  REQUIRE(count_color(m, MeshColor{20, 20, 22, 255}) == 2 * 5);
+
+  m.build(make_rect(), TrackMeshParams{2.0f, 12.0f, 0});
+  REQUIRE(count_color(m, MeshColor{255, 255, 255, 30}) == 0);
+}
+
+TEST_CASE("TrackMesh of an empty path is empty") {
+  TrackMesh m;
+  m.build(TrackPath{}, TrackMeshParams{});
+  REQUIRE(m.vertices().empty());
+  REQUIRE(m.triangle_count() == 0);
+}
+
+TEST_CASE("TrackMesh visible() returns only chunks overlapping the view, in layer order") {
+  const auto path = TrackPath::Stadium(600.0, 120.0, 48);
+  TrackMesh m;
+  m.build(path, TrackMeshParams{4.0f, 12.0f, 4});
+  REQUIRE(m.chunk_count() > 4);
+
+  std::vector<TrackMesh::VertexRange> all, part, none;
+  m.visible(Box2{-1e6f, -1e6f, 1e6f, 1e6f}, all);
+  std::size_t all_verts = 0;
+  for (const auto& r : all) all_verts += r.end - r.begin;
+  REQUIRE(all_verts == m.vertices().size());
+
+  // A 400 x 300 px window around the start line.
+  const float sx = float(path.points()[0].x * 4.0), sy = float(-path.points()[0].y * 4.0);
+  m.visible(Box2{sx - 200.0f, sy - 150.0f, sx + 200.0f, sy + 150.0f}, part);
+  std::size_t part_verts = 0;
+  for (std::size_t i = 0; i < part.size(); ++i) {
+    part_verts += part[i].end - part[i].begin;
+    if (i > 0) REQUIRE(part[i].begin >= part[i - 1].end); // draw order preserved
+  }
+  REQUIRE(part_verts > 0);
+  REQUIRE(part_verts * 4 < all_verts);
+
+  m.visible(Box2{1e5f, 1e5f, 1e5f + 10.0f, 1e5f + 10.0f}, none);
+  REQUIRE(none.empty());
+}
+
+TEST_CASE("TrackMesh builds from a decimated outline") {
+  const auto path = TrackPath::Stadium(600.0, 120.0, 48);
+  TrackLod lod;
+  lod.build(path);
+  TrackMesh full, coarse;
+  full.build(path, TrackMeshParams{0.2f, 12.0f, 0});
+  coarse.build(path, TrackMeshParams{0.2f, 12.0f, 0}, lod.points_for(0.2f));
+  REQUIRE(coarse.triangle_count() < full.triangle_count());
+}